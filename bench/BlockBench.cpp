@@ -0,0 +1,229 @@
+#include <eeros/control/Block1o.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/D.hpp>
+#include <eeros/control/DeMux.hpp>
+#include <eeros/control/Delay.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/I.hpp>
+#include <eeros/control/MAFilter.hpp>
+#include <eeros/control/MedianFilter.hpp>
+#include <eeros/control/Mul.hpp>
+#include <eeros/control/Mux.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <eeros/control/SignalChecker.hpp>
+#include <eeros/control/Step.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Switch.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::control;
+using namespace eeros::math;
+
+namespace {
+
+// delivers a value which changes in every cycle, with a timestamp advancing by 1 ms,
+// without reading the clock like Constant does
+template < typename T = double >
+class Source : public Block1o<T> {
+ public:
+  Source(T value) : value(value), step(value) { this->out.getSignal().setTimestamp(0); }
+  virtual void run() {
+    value += step;
+    this->out.getSignal().setValue(value);
+    this->out.getSignal().setTimestamp(this->out.getSignal().getTimestamp() + 1000000);
+  }
+  T value, step;
+};
+
+// runs a block with a single input fed by a source, the source is run in every cycle too
+template < typename B, typename T >
+void runFed(benchmark::State& state, B& block, T value) {
+  Source<T> source(value);
+  block.getIn().connect(source.getOut());
+  for (auto _ : state) {
+    source.run();
+    block.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// runs a block without inputs
+template < typename B >
+void runAlone(benchmark::State& state, B& block) {
+  for (auto _ : state) {
+    block.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// the cost of the source, which is included in all benchmarks of blocks with inputs
+void BlockSource(benchmark::State& state) {
+  Source<> b(0.001);
+  runAlone(state, b);
+}
+
+void BlockConstant(benchmark::State& state) {
+  Constant<> b(1.0);
+  runAlone(state, b);
+}
+
+void BlockStep(benchmark::State& state) {
+  Step<> b(0.0, 1.0, 0.0);
+  runAlone(state, b);
+}
+
+void BlockGain(benchmark::State& state) {
+  Gain<> b(2.0);
+  runFed(state, b, 0.001);
+}
+
+void BlockGainMatrix(benchmark::State& state) {
+  Matrix<3, 3> m;
+  m << 1, 2, 3,
+       4, 5, 6,
+       7, 8, 9;
+  Gain<Vector3, Matrix<3, 3>> b(m);
+  runFed(state, b, Vector3(0.001));
+}
+
+void BlockD(benchmark::State& state) {
+  D<> b;
+  runFed(state, b, 0.001);
+}
+
+void BlockI(benchmark::State& state) {
+  I<> b;
+  b.setInitCondition(0.0);
+  b.enable();
+  runFed(state, b, 0.001);
+}
+
+void BlockDelay(benchmark::State& state) {
+  Delay<> b(0.01, 0.001);
+  runFed(state, b, 0.001);
+}
+
+void BlockSaturation(benchmark::State& state) {
+  Saturation<> b(-1.0, 1.0);
+  runFed(state, b, 0.001);
+}
+
+void BlockMAFilter(benchmark::State& state) {
+  double coeff[8] = {0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125};
+  MAFilter<8> b(coeff);
+  runFed(state, b, 0.001);
+}
+
+void BlockMedianFilter(benchmark::State& state) {
+  MedianFilter<9> b;
+  runFed(state, b, 0.001);
+}
+
+void BlockSignalChecker(benchmark::State& state) {
+  SignalChecker<> b(-1e9, 1e9);
+  runFed(state, b, 0.001);
+}
+
+void BlockDeMux(benchmark::State& state) {
+  DeMux<3> b;
+  runFed(state, b, Vector3(0.001));
+}
+
+void BlockSum(benchmark::State& state) {
+  Source<> s1(0.001), s2(0.002);
+  Sum<2> b;
+  b.getIn(0).connect(s1.getOut());
+  b.getIn(1).connect(s2.getOut());
+  for (auto _ : state) {
+    s1.run();
+    s2.run();
+    b.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BlockMul(benchmark::State& state) {
+  Source<> s1(0.001), s2(0.002);
+  Mul<> b;
+  b.getIn1().connect(s1.getOut());
+  b.getIn2().connect(s2.getOut());
+  for (auto _ : state) {
+    s1.run();
+    s2.run();
+    b.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BlockSwitch(benchmark::State& state) {
+  Source<> s1(0.001), s2(0.002);
+  Switch<2> b(1);
+  b.getIn(0).connect(s1.getOut());
+  b.getIn(1).connect(s2.getOut());
+  for (auto _ : state) {
+    s1.run();
+    s2.run();
+    b.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BlockMux(benchmark::State& state) {
+  Source<> s[3] = {{0.001}, {0.002}, {0.003}};
+  Mux<3> b;
+  for (int i = 0; i < 3; i++) b.getIn(i).connect(s[i].getOut());
+  for (auto _ : state) {
+    for (auto& x : s) x.run();
+    b.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// gain, sum and saturation in a chain, the accessors of the signals are inlined into straight-line code
+void BlockChain(benchmark::State& state) {
+  Source<> s1(0.001), s2(0.002);
+  Gain<> gain(2.0);
+  Sum<2> sum;
+  Saturation<> saturation(-1.0, 1.0);
+  gain.getIn().connect(s1.getOut());
+  sum.getIn(0).connect(gain.getOut());
+  sum.getIn(1).connect(s2.getOut());
+  saturation.getIn().connect(sum.getOut());
+  for (auto _ : state) {
+    s1.run();
+    s2.run();
+    gain.run();
+    sum.run();
+    saturation.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK(BlockSource);
+BENCHMARK(BlockConstant);
+BENCHMARK(BlockStep);
+BENCHMARK(BlockGain);
+BENCHMARK(BlockGainMatrix);
+BENCHMARK(BlockD);
+BENCHMARK(BlockI);
+BENCHMARK(BlockDelay);
+BENCHMARK(BlockSaturation);
+BENCHMARK(BlockMAFilter);
+BENCHMARK(BlockMedianFilter);
+BENCHMARK(BlockSignalChecker);
+BENCHMARK(BlockDeMux);
+BENCHMARK(BlockSum);
+BENCHMARK(BlockMul);
+BENCHMARK(BlockSwitch);
+BENCHMARK(BlockMux);
+BENCHMARK(BlockChain);
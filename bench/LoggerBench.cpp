@@ -0,0 +1,101 @@
+#include <eeros/logger/Logger.hpp>
+#include <eeros/logger/LogEntry.hpp>
+#include <eeros/logger/RealtimeLogWriter.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <ostream>
+
+using namespace eeros::logger;
+
+namespace {
+
+std::ostream nullStream(nullptr);  // discards everything
+
+Logger streamLogger() {
+  Logger::setDefaultStreamLogger(nullStream);
+  Logger log = Logger::getLogger('B');
+  log.show(LogLevel::INFO);
+  return log;
+}
+
+// suppressed at run time, the entry is created but does nothing
+void LogDisabledEntry(benchmark::State& state) {
+  Logger log = streamLogger();
+  double value = 1.0;
+  for (auto _ : state) {
+    log.trace() << "value = " << value;
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+// suppressed at run time, no entry is created and the arguments are not evaluated
+void LogDisabledMacro(benchmark::State& state) {
+  Logger log = streamLogger();
+  double value = 1.0;
+  for (auto _ : state) {
+    EEROS_LOG_TRACE(log) << "value = " << value;
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+// the macros expand at the place of use, lower the compile time level for the next benchmark only
+#pragma push_macro("EEROS_LOG_LEVEL")
+#undef EEROS_LOG_LEVEL
+#define EEROS_LOG_LEVEL 2
+
+// removed at compile time
+void LogCompiledOut(benchmark::State& state) {
+  Logger log = streamLogger();
+  double value = 1.0;
+  for (auto _ : state) {
+    EEROS_LOG_TRACE(log) << "value = " << value;
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+#pragma pop_macro("EEROS_LOG_LEVEL")
+
+void LogEnabledStream(benchmark::State& state) {
+  Logger log = streamLogger();
+  double value = 1.0;
+  for (auto _ : state) {
+    EEROS_LOG_INFO(log) << "value = " << value;
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+// the queue is mostly full, this measures the cost for the logging thread only
+void LogEnabledRealtime(benchmark::State& state) {
+  Logger::setDefaultRealtimeLogger(nullStream);
+  Logger log = Logger::getLogger('B');
+  log.show(LogLevel::INFO);
+  double value = 1.0;
+  for (auto _ : state) {
+    EEROS_LOG_INFO(log) << "value = " << value;
+    benchmark::DoNotOptimize(value);
+  }
+  state.counters["dropped"] = log.getDropped();
+}
+
+// construction and destruction of a bare entry without inserting anything,
+// range(0) selects the writer: none, stream suppressing the level, stream, realtime
+void LogEntryConstruct(benchmark::State& state) {
+  std::shared_ptr<LogWriter> writer;
+  if (state.range(0) == 1 || state.range(0) == 2) writer = std::make_shared<StreamLogWriter>(nullStream);
+  if (state.range(0) == 3) writer = std::make_shared<RealtimeLogWriter>(nullStream);
+  LogLevel level = (state.range(0) == 1) ? LogLevel::TRACE : LogLevel::INFO;  // writers show INFO by default
+  for (auto _ : state) {
+    LogEntry e(writer, level);
+    benchmark::DoNotOptimize(e);
+  }
+}
+
+}
+
+BENCHMARK(LogEntryConstruct)->DenseRange(0, 3);
+BENCHMARK(LogDisabledEntry);
+BENCHMARK(LogDisabledMacro);
+BENCHMARK(LogCompiledOut);
+BENCHMARK(LogEnabledStream);
+BENCHMARK(LogEnabledRealtime);
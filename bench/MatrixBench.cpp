@@ -0,0 +1,91 @@
+#include <eeros/math/Matrix.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::math;
+
+namespace {
+
+// well conditioned matrix with distinct elements
+template < unsigned int M, unsigned int N >
+Matrix<M, N> filled() {
+  Matrix<M, N> m;
+  for (unsigned int i = 0; i < M; i++)
+    for (unsigned int j = 0; j < N; j++) m(i, j) = (i == j ? M + N : 0) + 0.1 * (i * N + j);
+  return m;
+}
+
+template < unsigned int M, unsigned int N, unsigned int K >
+void MatrixMul(benchmark::State& state) {
+  auto a = filled<M, N>();
+  auto b = filled<N, K>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a * b);
+  }
+}
+
+template < unsigned int M, unsigned int N >
+void MatrixScale(benchmark::State& state) {
+  auto a = filled<M, N>();
+  double s = 0.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a * s);
+  }
+}
+
+template < unsigned int M, unsigned int N >
+void MatrixAdd(benchmark::State& state) {
+  auto a = filled<M, N>();
+  auto b = filled<M, N>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a + b);
+  }
+}
+
+template < unsigned int M, unsigned int N >
+void MatrixTranspose(benchmark::State& state) {
+  auto a = filled<M, N>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a.transpose());
+  }
+}
+
+template < unsigned int N >
+void MatrixDet(benchmark::State& state) {
+  auto a = filled<N, N>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a.det());
+  }
+}
+
+template < unsigned int N >
+void MatrixInverse(benchmark::State& state) {
+  auto a = filled<N, N>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(!a);
+  }
+}
+
+}
+
+BENCHMARK_TEMPLATE(MatrixMul, 3, 3, 1);
+BENCHMARK_TEMPLATE(MatrixMul, 3, 3, 3);
+BENCHMARK_TEMPLATE(MatrixMul, 4, 4, 4);
+BENCHMARK_TEMPLATE(MatrixMul, 6, 6, 1);
+BENCHMARK_TEMPLATE(MatrixMul, 6, 6, 6);
+BENCHMARK_TEMPLATE(MatrixScale, 3, 3);
+BENCHMARK_TEMPLATE(MatrixScale, 6, 6);
+BENCHMARK_TEMPLATE(MatrixAdd, 3, 1);
+BENCHMARK_TEMPLATE(MatrixAdd, 3, 3);
+BENCHMARK_TEMPLATE(MatrixAdd, 6, 6);
+BENCHMARK_TEMPLATE(MatrixTranspose, 3, 3);
+BENCHMARK_TEMPLATE(MatrixTranspose, 6, 6);
+BENCHMARK_TEMPLATE(MatrixDet, 3);
+BENCHMARK_TEMPLATE(MatrixDet, 4);
+BENCHMARK_TEMPLATE(MatrixInverse, 3);
+BENCHMARK_TEMPLATE(MatrixInverse, 4);
@@ -0,0 +1,89 @@
+#include <eeros/core/RingBuffer.hpp>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+
+// push and pop one item in the same thread, measures the bare cost of both calls
+template < typename Buffer >
+void RingBufferPushPop(benchmark::State& state) {
+  Buffer rb;
+  uint64_t v = 0;
+  for (auto _ : state) {
+    rb.push(v);
+    rb.pop(v);
+    benchmark::DoNotOptimize(v);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// push and pop a batch of range(0) items in the same thread
+template < typename Buffer >
+void RingBufferBatch(benchmark::State& state) {
+  Buffer rb;
+  const std::size_t n = state.range(0);
+  uint64_t batch[64] = {};
+  for (auto _ : state) {
+    rb.push(batch, n);
+    rb.pop(batch, n);
+    benchmark::DoNotOptimize(batch);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// with two threads, thread 0 produces and thread 1 consumes,
+// with more threads, thread 0 consumes the items of all other threads
+template < typename Buffer >
+void RingBufferThroughput(benchmark::State& state) {
+  static Buffer rb;
+  const bool producer = (state.thread_index() == 0) != (state.threads() > 2);
+  uint64_t v = 0;
+  for (auto _ : state) {
+    if (producer) {
+      while (!rb.push(v)) std::this_thread::yield();
+    } else {
+      for (int i = 1; i < state.threads(); i++) {
+        while (!rb.pop(v)) std::this_thread::yield();
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// round trip of one item to an echo thread and back
+template < typename Buffer >
+void RingBufferLatency(benchmark::State& state) {
+  Buffer request, reply;
+  std::atomic<bool> stop(false);
+  std::thread echo([&] {
+    uint64_t v;
+    while (!stop) {
+      if (request.pop(v)) reply.push(v);
+      else std::this_thread::yield();
+    }
+  });
+  uint64_t v = 0;
+  for (auto _ : state) {
+    request.push(v);
+    while (!reply.pop(v)) std::this_thread::yield();
+  }
+  stop = true;
+  echo.join();
+}
+
+using Spsc = SpscRingBuffer<uint64_t, 1024>;
+using Mpsc = MpscRingBuffer<uint64_t, 1024>;
+
+}
+
+BENCHMARK_TEMPLATE(RingBufferPushPop, Spsc);
+BENCHMARK_TEMPLATE(RingBufferPushPop, Mpsc);
+BENCHMARK_TEMPLATE(RingBufferBatch, Spsc)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(RingBufferBatch, Mpsc)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(RingBufferThroughput, Spsc)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(RingBufferThroughput, Mpsc)->Threads(2)->Threads(4)->UseRealTime();
+BENCHMARK_TEMPLATE(RingBufferLatency, Spsc)->UseRealTime();
+BENCHMARK_TEMPLATE(RingBufferLatency, Mpsc)->UseRealTime();
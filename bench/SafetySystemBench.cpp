@@ -0,0 +1,71 @@
+#include <eeros/safety/SafetySystem.hpp>
+#include <eeros/safety/SafetyProperties.hpp>
+#include <eeros/safety/InputAction.hpp>
+#include <eeros/safety/OutputAction.hpp>
+#include <eeros/hal/Input.hpp>
+#include <eeros/hal/Output.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::safety;
+
+namespace {
+
+class BoolInput : public hal::Input<bool> {
+ public:
+  BoolInput(std::string id) : hal::Input<bool>(id, nullptr) { }
+  virtual bool get() { return true; }
+};
+
+class BoolOutput : public hal::Output<bool> {
+ public:
+  BoolOutput(std::string id) : hal::Output<bool>(id, nullptr), value(false) { }
+  virtual bool get() { return value; }
+  virtual void set(bool v) { value = v; }
+  bool value;
+};
+
+// three levels, in every level all n critical inputs are checked and all n critical outputs are set,
+// the inputs never trigger an event, so the safety system stays in its entry level
+class Properties : public SafetyProperties {
+ public:
+  Properties(int n) : slOff("off"), slRunning("running"), slEmergency("emergency"), seEmergency("emergency") {
+    for (int i = 0; i < n; i++) {
+      inputs.emplace_back(new BoolInput("in" + std::to_string(i)));
+      outputs.emplace_back(new BoolOutput("out" + std::to_string(i)));
+      criticalInputs.push_back(inputs.back().get());
+      criticalOutputs.push_back(outputs.back().get());
+    }
+    addLevel(slOff);
+    addLevel(slRunning);
+    addLevel(slEmergency);
+    for (auto level : {&slOff, &slRunning, &slEmergency}) {
+      for (auto& in : inputs) level->setInputAction(check<bool>(in.get(), true, seEmergency));
+      for (auto& out : outputs) level->setOutputAction(set<bool>(out.get(), level == &slRunning));
+    }
+    addEventToLevelAndAbove(slOff, seEmergency, slEmergency, kPrivateEvent);
+    slRunning.setLevelAction([](SafetyContext*) { });
+    setEntryLevel(slRunning);
+  }
+  std::vector<std::unique_ptr<BoolInput>> inputs;
+  std::vector<std::unique_ptr<BoolOutput>> outputs;
+  SafetyLevel slOff, slRunning, slEmergency;
+  SafetyEvent seEmergency;
+};
+
+void SafetySystemRun(benchmark::State& state) {
+  Properties properties(state.range(0));
+  SafetySystem ss(properties, 0.001);
+  for (auto _ : state) {
+    ss.run();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK(SafetySystemRun)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
@@ -0,0 +1,105 @@
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <eeros/control/D.hpp>
+#include <eeros/control/I.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace eeros::control;
+
+namespace {
+
+// Chain of gain blocks fed by a constant, added to the time domain in reverse order
+struct GainChain {
+  GainChain(int n) : td("bench", 0.001, false), c(1.0) {
+    for (int i = 0; i < n; i++) gains.emplace_back(new Gain<>(1.0));
+    gains[0]->getIn().connect(c.getOut());
+    for (int i = 1; i < n; i++) gains[i]->getIn().connect(gains[i - 1]->getOut());
+    for (int i = n - 1; i >= 0; i--) td.addBlock(gains[i].get());
+    td.addBlock(c);
+  }
+  TimeDomain td;
+  Constant<> c;
+  std::vector<std::unique_ptr<Gain<>>> gains;
+};
+
+// Typical controller mix of n blocks fed by a constant: sums fed by the two preceding blocks,
+// gains, saturations, differentiators and integrators, added in a shuffled order
+struct Mixed {
+  Mixed(int n) : td("bench", 0.001, false), c(0.001) {
+    Output<>* prev[2] = {&c.getOut(), &c.getOut()};
+    for (int i = 0; i < n; i++) {
+      Output<>* out;
+      switch (i % 5) {
+        case 0: {
+          auto s = add(new Sum<2>());
+          s->getIn(0).connect(*prev[0]);
+          s->getIn(1).connect(*prev[1]);
+          out = &s->getOut();
+          break;
+        }
+        case 1: out = &add(new Gain<>(0.5), *prev[0])->getOut(); break;
+        case 2: out = &add(new Saturation<>(-1.0, 1.0), *prev[0])->getOut(); break;
+        case 3: out = &add(new D<>(), *prev[0])->getOut(); break;
+        default: {
+          auto integrator = add(new I<>(), *prev[0]);
+          integrator->setInitCondition(0.0);
+          integrator->enable();
+          out = &integrator->getOut();
+        }
+      }
+      prev[1] = prev[0];
+      prev[0] = out;
+    }
+    std::vector<Block*> order;
+    for (auto& b : blocks) order.push_back(b.get());
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    for (auto b : order) td.addBlock(b);
+    td.addBlock(c);
+  }
+  template < typename B >
+  B* add(B* b) {
+    blocks.emplace_back(b);
+    return b;
+  }
+  template < typename B >
+  B* add(B* b, Output<>& in) {
+    b->getIn().connect(in);
+    return add(b);
+  }
+  TimeDomain td;
+  Constant<> c;
+  std::vector<std::unique_ptr<Block>> blocks;
+};
+
+void TimeDomainList(benchmark::State& state) {
+  GainChain chain(state.range(0));
+  for (auto _ : state) chain.td.run();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void TimeDomainCompiled(benchmark::State& state) {
+  GainChain chain(state.range(0));
+  chain.td.compile();
+  for (auto _ : state) chain.td.run();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void TimeDomainMixed(benchmark::State& state) {
+  Mixed mixed(state.range(0));
+  mixed.td.compile();
+  for (auto _ : state) mixed.td.run();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(TimeDomainList)->Arg(10)->Arg(40)->Arg(100);
+BENCHMARK(TimeDomainCompiled)->Arg(10)->Arg(40)->Arg(100);
+BENCHMARK(TimeDomainMixed)->Arg(10)->Arg(40)->Arg(100);
@@ -0,0 +1,60 @@
+#include <eeros/core/Semaphore.hpp>
+#include <eeros/core/Wakeup.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+
+uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct SpinningWakeup : Wakeup {
+  SpinningWakeup() : Wakeup(10000) { }
+};
+
+// The benchmark thread posts like the executor, a worker thread waits like an Async thread 
+// and records the time from the post until it is running. The worker replies, so every 
+// post finds the worker waiting. Percentiles of the wakeup latency are reported as counters.
+template < typename Primitive >
+void WakeupLatency(benchmark::State& state) {
+  Primitive request, reply;
+  std::unique_ptr<Histogram> latency(new Histogram());
+  std::atomic<uint64_t> posted(0);
+  std::atomic<bool> stop(false);
+  std::thread worker([&] {
+    while (true) {
+      request.wait();
+      if (stop) break;
+      latency->add(now() - posted.load(std::memory_order_relaxed));
+      reply.post();
+    }
+  });
+  for (auto _ : state) {
+    posted.store(now(), std::memory_order_relaxed);
+    request.post();
+    reply.wait();
+  }
+  stop = true;
+  request.post();
+  worker.join();
+
+  std::unique_ptr<Histogram::Snapshot> s(new Histogram::Snapshot());
+  latency->snapshot(*s);
+  state.counters["p50_ns"] = s->percentile(50);
+  state.counters["p99_ns"] = s->percentile(99);
+  state.counters["p99.9_ns"] = s->percentile(99.9);
+  state.counters["max_ns"] = s->max;
+}
+
+}
+
+BENCHMARK_TEMPLATE(WakeupLatency, Semaphore)->UseRealTime();
+BENCHMARK_TEMPLATE(WakeupLatency, Wakeup)->UseRealTime();
+BENCHMARK_TEMPLATE(WakeupLatency, SpinningWakeup)->UseRealTime();
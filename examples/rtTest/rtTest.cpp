@@ -66,7 +66,7 @@ int main(int argc, char *argv[]) {
 	SafetyPropertiesTest ssProperties;
 	SafetySystem safetySys(ssProperties, dt);
 
-	auto executor = eeros::Executor::instance();
+	auto &executor = eeros::Executor::instance();
 	eeros::task::Periodic ss("ss", dt, safetySys);
 	executor.setMainTask(ss);
 	ss.monitors.push_back([&](eeros::PeriodicCounter &c, Logger &log){
@@ -1,39 +1,76 @@
-#ifndef ORG_EEROS_CONTROL_BLOCK_HPP_
-#define ORG_EEROS_CONTROL_BLOCK_HPP_
-
-#include <string>
-#include <eeros/core/Runnable.hpp>
-
-namespace eeros {
-namespace control {
-
-/**
- * This is the base class for all blocks used in a control system.
- * 
- * @since v0.4
- */
-
-class Block : public Runnable {
- public:
-  /**
-   * Sets the name of the block.
-   * 
-   * @tparam name - name of the block
-   */
-  virtual void setName(std::string name);
-
-  /**
-   * Gets the name of the block.
-   * 
-   * @return name
-   */
-  virtual std::string getName() const;
-  
- private:
-  std::string name;
-};
-
-};
-};
-
-#endif /* ORG_EEROS_CONTROL_BLOCK_HPP_ */
+#ifndef ORG_EEROS_CONTROL_BLOCK_HPP_
+#define ORG_EEROS_CONTROL_BLOCK_HPP_
+
+#include <string>
+#include <vector>
+#include <eeros/core/Runnable.hpp>
+#include <eeros/control/InputInterface.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * This is the base class for all blocks used in a control system.
+ * 
+ * @since v0.4
+ */
+
+class Block : public Runnable {
+ public:
+  Block() = default;
+
+  /**
+   * Disabling use of copy constructor because the inputs and outputs of a copy
+   * would still be owned by the original block.
+   */
+  Block(const Block& b) = delete;
+
+  /**
+   * Sets the name of the block.
+   * 
+   * @tparam name - name of the block
+   */
+  virtual void setName(std::string name);
+
+  /**
+   * Gets the name of the block.
+   * 
+   * @return name
+   */
+  virtual std::string getName() const;
+
+  /**
+   * Registers an input owned by this block. Inputs do this on their own
+   * as soon as their owner is set.
+   * 
+   * @param input - input owned by this block
+   */
+  void registerInput(InputInterface* input);
+
+  /**
+   * Gets all inputs which are owned by this block.
+   * 
+   * @return inputs
+   */
+  const std::vector<InputInterface*>& getInputs() const;
+
+  /**
+   * Tells whether the inputs of this block affect its outputs within the same 
+   * cycle. Blocks which only pass on values of former cycles, e.g. a delay, 
+   * return false. A time domain then does not need to run the blocks delivering 
+   * their inputs first, so a feedback loop through such a block is no algebraic loop.
+   * 
+   * @return true, if the outputs depend on the current inputs
+   * @since v1.3
+   */
+  virtual bool hasDirectFeedthrough() const;
+  
+ private:
+  std::string name;
+  std::vector<InputInterface*> inputs;
+};
+
+};
+};
+
+#endif /* ORG_EEROS_CONTROL_BLOCK_HPP_ */
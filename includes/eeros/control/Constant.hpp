@@ -4,7 +4,7 @@
 #include <type_traits>
 #include <mutex>
 #include <eeros/control/Block1o.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 
 namespace eeros {
 namespace control {
@@ -49,7 +49,7 @@ class Constant : public Block1o<T> {
   virtual void run() {
     std::lock_guard<std::mutex> lock(mtx);
     this->out.getSignal().setValue(value);
-    this->out.getSignal().setTimestamp(System::getTimeNs());
+    this->out.getSignal().setTimestamp(CycleTime::now());
   }
   
   /**
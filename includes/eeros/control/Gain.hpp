@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_GAIN_HPP_
 
 #include <eeros/control/Block1i1o.hpp>
+#include <eeros/control/Transition.hpp>
 #include <type_traits>
 #include <memory>
 #include <mutex>
@@ -23,7 +24,9 @@ namespace control {
  * The non-type template argument specifies if the multiplication will be done
  * element wise in case the gain is used with matrices.
  *
- * A gain block is suitable for use with multiple threads. However,
+ * A gain block is suitable for use with multiple threads. The setters
+ * pass the gain and its limits lock-free to run(), which takes them over
+ * at the start of its next cycle and never blocks. However,
  * enabling/disabling of the gain and the smooth change feature
  * is not synchronized.
  *
@@ -56,6 +59,8 @@ class Gain : public Block1i1o<Tout> {
    */
   Gain(Tgain c) : Gain(c, 1.0, -1.0) { // 1.0 and -1.0 are temp values only.
     resetMinMaxGain<Tgain>(); // set limits to smallest/largest value.
+    pending.maxGain = maxGain;
+    pending.minGain = minGain;
   }
 
 
@@ -69,12 +74,14 @@ class Gain : public Block1i1o<Tout> {
    * @param maxGain - initial maximum gain value
    * @param minGain - initial minimum gain value
    */
-  Gain(Tgain c, Tgain maxGain, Tgain minGain) {
+  Gain(Tgain c, Tgain maxGain, Tgain minGain) : parameters(Parameters()) {
     gain = c;
     this->maxGain = maxGain;
     this->minGain = minGain;
     targetGain = gain;
     gainDiff = 0;
+    pending = {c, maxGain, minGain, gainDiff, 0};
+    request = 0;
   }
 
   
@@ -103,7 +110,20 @@ class Gain : public Block1i1o<Tout> {
    * @see disable()
    */
   virtual void run() {
-    std::lock_guard<std::mutex> lock(mtx);
+    if (parameters.update()) {
+      auto& p = parameters.readBuffer();
+      maxGain = p.maxGain;
+      minGain = p.minGain;
+      gainDiff = p.gainDiff;
+      if (p.request != request) {
+        request = p.request;
+        if (smoothChange) {
+          targetGain = p.gain;
+        } else {
+          gain = p.gain;
+        }
+      }
+    }
 
     if (smoothChange) {
       if (gain < targetGain) {
@@ -194,17 +214,17 @@ class Gain : public Block1i1o<Tout> {
    *
    * Does not change gain or target gain value otherwise.
    *
+   * The value is taken over by the next call of run().
+   *
    * @param c - gain value
    */
   virtual void setGain(Tgain c) {
     std::lock_guard<std::mutex> lock(mtx);
 
-    if (c <= maxGain && c >= minGain) {
-      if (smoothChange) {
-        targetGain = c;
-      } else {
-        gain = c;
-      }
+    if (c <= pending.maxGain && c >= pending.minGain) {
+      pending.gain = c;
+      pending.request++;
+      publish();
     }
   }
 
@@ -216,7 +236,8 @@ class Gain : public Block1i1o<Tout> {
    */
   virtual void setMaxGain(Tgain maxGain) {
     std::lock_guard<std::mutex> lock(mtx);
-    this->maxGain = maxGain;
+    pending.maxGain = maxGain;
+    publish();
   }
 
 
@@ -227,7 +248,8 @@ class Gain : public Block1i1o<Tout> {
    */
   virtual void setMinGain(Tgain minGain) {
     std::lock_guard<std::mutex> lock(mtx);
-    this->minGain = minGain;
+    pending.minGain = minGain;
+    publish();
   }
 
 
@@ -238,7 +260,8 @@ class Gain : public Block1i1o<Tout> {
    */
   virtual void setGainDiff(Tgain gainDiff) {
     std::lock_guard<std::mutex> lock(mtx);
-    this->gainDiff = gainDiff;
+    pending.gainDiff = gainDiff;
+    publish();
   }
 
 
@@ -258,10 +281,29 @@ class Gain : public Block1i1o<Tout> {
   Tgain gainDiff;
   bool enabled{true};
   bool smoothChange{false};
-  std::mutex mtx;
+  std::mutex mtx; // serializes the setters, run() does not lock it
 
 
  private:
+  // values of the setters, request counts the calls of setGain()
+  struct Parameters {
+    Tgain gain;
+    Tgain maxGain;
+    Tgain minGain;
+    Tgain gainDiff;
+    uint32_t request;
+  };
+
+  void publish() {
+    parameters.writeBuffer() = pending;
+    parameters.publish();
+  }
+
+  TransitionBuffer<Parameters> parameters;
+  Parameters pending; // latest values of the setters
+  uint32_t request; // last request taken over by run()
+
+
   template<typename S>
   typename std::enable_if<!elementWise, S>::type calculateResults(S value) {
     return gain * value;
@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_INPUT_HPP_
 
 #include <eeros/control/NotConnectedFault.hpp>
+#include <eeros/control/InputInterface.hpp>
 #include <eeros/control/Signal.hpp>
 #include <eeros/control/Output.hpp>
 #include <eeros/control/Block.hpp>
@@ -12,13 +13,15 @@ namespace control {
 /**
  * Blocks can have inputs and outputs. This is the input class.
  * An input can be connected to an output of another block.
+ * The class is final, so that accessing the signal is inlined down to 
+ * a check of the connection, see getSignal().
  * 
  * @tparam T - signal type (double - default type)
  * @since v0.4
  */
 
 template < typename T = double >
-class Input {
+class Input final : public InputInterface {
  public:
   /**
    * Constructs an input instance.
@@ -30,7 +33,9 @@ class Input {
    *
    * @param owner - the block which owns this input
    */
-  Input(Block* owner) : connectedOutput(nullptr), owner(owner) { }
+  Input(Block* owner) : connectedOutput(nullptr), owner(nullptr) {
+    setOwner(owner);
+  }
 
   /**
    * Connects an existing output of any other block to this input.
@@ -75,15 +80,13 @@ class Input {
   /**
    * Returns the signal which is carried by the output to which
    * this input is connected. If the input is not connected an NotConnectedFault
-   * is thrown.
+   * is thrown. Time domains report unconnected inputs when they are compiled.
    * 
    * @return signal 
    */
   virtual Signal<T>& getSignal() {
-    if(isConnected()) return connectedOutput->getSignal();
-    std::string name;
-    if (owner != nullptr) name = owner->getName(); else name = "";
-      throw NotConnectedFault("Read from an unconnected input in block '" + name + "'");
+    if (connectedOutput != nullptr) return connectedOutput->getSignal();
+    notConnected();
   }
             
   /**
@@ -93,11 +96,39 @@ class Input {
    */
   virtual void setOwner(Block* block) {
     owner = block;
+    if (owner != nullptr) owner->registerInput(this);
+  }
+
+  /**
+   * Gets the block which owns this input.
+   * 
+   * @return owner
+   */
+  virtual Block* getOwner() const {
+    return owner;
+  }
+
+  /**
+   * Gets the block which owns the output this input is connected to.
+   * 
+   * @return block delivering the signal, nullptr if not connected
+   */
+  virtual Block* getConnectedBlock() const {
+    if (isConnected()) return connectedOutput->getOwner();
+    return nullptr;
   }
             
  protected:
   Output<T>* connectedOutput;
   Block* owner;
+
+ private:
+  // kept out of getSignal(), so that the check of the connection is all that is inlined
+  [[noreturn]] __attribute__((noinline)) void notConnected() const {
+    std::string name;
+    if (owner != nullptr) name = owner->getName(); else name = "";
+    throw NotConnectedFault("Read from an unconnected input in block '" + name + "'");
+  }
  };
 
 }
@@ -0,0 +1,46 @@
+#ifndef ORG_EEROS_CONTROL_INPUTINTERFACE_HPP_
+#define ORG_EEROS_CONTROL_INPUTINTERFACE_HPP_
+
+namespace eeros {
+namespace control {
+
+class Block;
+
+/**
+ * Type independent view of an input. It allows to walk the connections
+ * between blocks without knowing the signal type carried by the inputs,
+ * e.g. when a time domain sorts its blocks by their data dependencies.
+ * 
+ * @since v1.3
+ */
+
+class InputInterface {
+ public:
+  virtual ~InputInterface() { }
+
+  /**
+   * Queries the connection state of this input.
+   * 
+   * @return true, if connection exists to output of another block 
+   */
+  virtual bool isConnected() const = 0;
+
+  /**
+   * Gets the block which owns this input.
+   * 
+   * @return owner, nullptr if no owner is set
+   */
+  virtual Block* getOwner() const = 0;
+
+  /**
+   * Gets the block which owns the output this input is connected to.
+   * 
+   * @return block delivering the signal, nullptr if not connected or if the output has no owner
+   */
+  virtual Block* getConnectedBlock() const = 0;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_INPUTINTERFACE_HPP_ */
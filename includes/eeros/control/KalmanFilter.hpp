@@ -1,7 +1,7 @@
 #ifndef ORG_EEROS_CONTROL_KALMANFILTER_HPP_
 #define ORG_EEROS_CONTROL_KALMANFILTER_HPP_
 
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 #include <eeros/control/Block.hpp>
 #include <eeros/control/Input.hpp>
 #include <eeros/control/Output.hpp>
@@ -219,10 +219,11 @@ public:
         std::lock_guard<std::mutex> lock(mtx);
         u.run();
         x = Ad * x + Bd * u.getOut().getSignal().getValue();
+        timestamp_t time = eeros::CycleTime::now();
         for (uint8_t i = 0; i < Nr_Of_States; i++)
         {
             out[i].getSignal().setValue(x[i]);
-            out[i].getSignal().setTimestamp(eeros::System::getTimeNs());
+            out[i].getSignal().setTimestamp(time);
         }
         P = Ad * P * Ad.transpose() + GdQGdT;
     }
@@ -235,10 +236,11 @@ public:
         std::lock_guard<std::mutex> lock(mtx);
         if (first)
         {
+            timestamp_t time = eeros::CycleTime::now();
             for (uint8_t i = 0; i < Nr_Of_States; i++)
             {
                 out[i].getSignal().setValue(x[i]);
-                out[i].getSignal().setTimestamp(eeros::System::getTimeNs());
+                out[i].getSignal().setTimestamp(time);
             }
             first = false;
         }
@@ -250,10 +252,11 @@ public:
             K = P * C.transpose() * !CPCTR;
             dy = y.getOut().getSignal().getValue() - C * x - D * u.getOut().getSignal().getValue();
             x = x + K * dy;
+            timestamp_t time = eeros::CycleTime::now();
             for (uint8_t i = 0; i < Nr_Of_States; i++)
             {
                 out[i].getSignal().setValue(x[i]);
-                out[i].getSignal().setTimestamp(eeros::System::getTimeNs());
+                out[i].getSignal().setTimestamp(time);
             }
             P = (eye - K * C) * P;
         }
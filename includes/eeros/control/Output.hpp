@@ -10,14 +10,15 @@ namespace control {
 /**
  * Blocks can have inputs and outputs. This is the output class.
  * An output carries a signal. One or several inputs of other blocks
- * can be connected to this output.
+ * can be connected to this output. The class is final, so that accessing 
+ * the signal is inlined.
  * 
  * @tparam T - signal type (double - default type)
  * @since v0.4
  */
 
 template < typename T = double >
-class Output {
+class Output final {
  public:
   /**
    * Constructs an output instance.
@@ -41,14 +42,23 @@ class Output {
   }
 
   /**
-   * Every input is owned by a block. Sets the owner of this input.
+   * Every output is owned by a block. Sets the owner of this output.
    * 
-   * @param block - owner of this input
+   * @param block - owner of this output
    */
   virtual void setOwner(Block* block) {
     owner = block;
   }
 
+  /**
+   * Gets the block which owns this output.
+   * 
+   * @return owner
+   */
+  virtual Block* getOwner() const {
+    return owner;
+  }
+
  private:
   Signal<T> signal;
   Block* owner;
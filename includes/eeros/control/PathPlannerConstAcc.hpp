@@ -3,7 +3,7 @@
 
 #include <eeros/control/Output.hpp>
 #include <eeros/control/TrajectoryGenerator.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 #include <cmath>
 #include <mutex>
 
@@ -44,7 +44,7 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
    * @param dt - sampling time
    */
   PathPlannerConstAcc(T velMax, T acc, T dec, double dt) 
-      : finished(true), velMax(velMax), acc(acc), dec(dec), dt(dt) { 
+      : posOut(this), velOut(this), accOut(this), finished(true), velMax(velMax), acc(acc), dec(dec), dt(dt) { 
     posOut.getSignal().clear();
     velOut.getSignal().clear();
     accOut.getSignal().clear();
@@ -129,7 +129,7 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
     velOut.getSignal().setValue(y[1]);
     accOut.getSignal().setValue(y[2]);
 
-    timestamp_t time = System::getTimeNs(); 
+    timestamp_t time = CycleTime::now(); 
     posOut.getSignal().setTimestamp(time);
     velOut.getSignal().setTimestamp(time);
     accOut.getSignal().setTimestamp(time);
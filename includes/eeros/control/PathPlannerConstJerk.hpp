@@ -3,7 +3,7 @@
 
 #include <eeros/control/Output.hpp>
 #include <eeros/control/TrajectoryGenerator.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 #include <cmath>
 #include <mutex>
 
@@ -45,7 +45,7 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
    * @param dt - sampling time
    */
   PathPlannerConstJerk(T velMax, T jerk, double dt) 
-      : finished(true), velMax(velMax), jerk(jerk), dt(dt) {
+      : posOut(this), velOut(this), accOut(this), jerkOut(this), finished(true), velMax(velMax), jerk(jerk), dt(dt) {
     posOut.getSignal().clear();
     velOut.getSignal().clear();
     accOut.getSignal().clear();
@@ -161,7 +161,7 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
     accOut.getSignal().setValue(y[2]);
     jerkOut.getSignal().setValue(y[3]);
 
-    timestamp_t time = System::getTimeNs(); 
+    timestamp_t time = CycleTime::now(); 
     posOut.getSignal().setTimestamp(time);
     velOut.getSignal().setTimestamp(time);
     accOut.getSignal().setTimestamp(time);
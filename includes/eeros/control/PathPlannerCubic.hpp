@@ -4,7 +4,7 @@
 #include <eeros/control/Block.hpp>
 #include <eeros/control/Output.hpp>
 #include <eeros/math/Matrix.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 #include <iostream>
 #include <fstream>
 #include <unistd.h>
@@ -138,7 +138,7 @@ class PathPlannerCubic: public Block {
     accOut.getSignal().setValue(acc);
     jerkOut.getSignal().setValue(jerk);
     
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     posOut.getSignal().setTimestamp(time);
     velOut.getSignal().setTimestamp(time);
     accOut.getSignal().setTimestamp(time);
@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_PERIPHERALINPUT_HPP
 
 #include <eeros/control/Block1o.hpp>
+#include <eeros/control/SignalRecorder.hpp>
 #include <eeros/hal/HAL.hpp>
 #include <eeros/core/Fault.hpp>
 
@@ -15,6 +16,21 @@ namespace eeros {
 			PeripheralInput(std::string id, bool exclusive = true) : hal(hal::HAL::instance()) {
 				systemInput = dynamic_cast<eeros::hal::Input<T>*>(hal.getInput(id, exclusive));
 				if(systemInput == nullptr) throw Fault("Peripheral input '" + id + "' not found!");
+				SignalRecorder::registerPeripheral(this->out, id);
+			}
+			
+			virtual ~PeripheralInput() {
+				SignalRecorder::unregisterPeripheral(this);
+			}
+			
+			/**
+			 * Gets the id of the HAL input read by this block.
+			 * 
+			 * @return id
+			 * @since v1.3
+			 */
+			std::string getId() const {
+				return systemInput->getId();
 			}
 			
 			virtual void run() {
@@ -16,13 +16,15 @@ extern uint16_t signalCounter;
 /**
  * A signal comprises several properties such as a value and a timestamp.
  * It is used to transport information between blocks of a control system.
+ * The class is final, so that the compiler resolves and inlines the calls 
+ * of the accessors, SignalInterface keeps it accessible for introspection.
  *
  * @tparam T - signal type (double - default type)
  * @since v0.4
  */
 
 template < typename T = double >
-class Signal : public SignalInterface {
+class Signal final : public SignalInterface {
  public:
   /**
    * Constructs a signal instance.
@@ -0,0 +1,329 @@
+#ifndef ORG_EEROS_CONTROL_SIGNALRECORDER_HPP_
+#define ORG_EEROS_CONTROL_SIGNALRECORDER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <eeros/control/Block.hpp>
+#include <eeros/control/Input.hpp>
+#include <eeros/control/Output.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/hal/Input.hpp>
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+namespace control {
+
+class TimeDomain;
+
+/**
+ * Type of the values of a recorded channel, other for any type which is not a
+ * plain number, e.g. a matrix.
+ *
+ * @since v1.3
+ */
+enum class RecordType : uint8_t { other, boolean, int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64 };
+
+template < typename T > struct RecordTypeOf { static constexpr RecordType value = RecordType::other; };
+template <> struct RecordTypeOf<bool> { static constexpr RecordType value = RecordType::boolean; };
+template <> struct RecordTypeOf<int8_t> { static constexpr RecordType value = RecordType::int8; };
+template <> struct RecordTypeOf<uint8_t> { static constexpr RecordType value = RecordType::uint8; };
+template <> struct RecordTypeOf<int16_t> { static constexpr RecordType value = RecordType::int16; };
+template <> struct RecordTypeOf<uint16_t> { static constexpr RecordType value = RecordType::uint16; };
+template <> struct RecordTypeOf<int32_t> { static constexpr RecordType value = RecordType::int32; };
+template <> struct RecordTypeOf<uint32_t> { static constexpr RecordType value = RecordType::uint32; };
+template <> struct RecordTypeOf<int64_t> { static constexpr RecordType value = RecordType::int64; };
+template <> struct RecordTypeOf<uint64_t> { static constexpr RecordType value = RecordType::uint64; };
+template <> struct RecordTypeOf<float> { static constexpr RecordType value = RecordType::float32; };
+template <> struct RecordTypeOf<double> { static constexpr RecordType value = RecordType::float64; };
+
+/**
+ * Description of a recorded channel.
+ *
+ * @since v1.3
+ */
+struct RecordChannel {
+  std::string name;   // id of the HAL input for peripheral inputs
+  RecordType type;
+  uint32_t size;      // size of a value in bytes
+  bool peripheral;    // recorded from a PeripheralInput
+};
+
+/**
+ * Records the values and timestamps of chosen signals in every cycle into a binary file,
+ * so that a run can be replayed offline with SignalReplay.
+ * The recorder is a block which is added to a time domain. Its inputs are connected to the
+ * recorded outputs, so it runs after the blocks delivering them. In every cycle, run() copies
+ * all values into a record of a preallocated ring buffer, it neither blocks nor allocates
+ * memory. A background thread without realtime priority writes the records to the file. If the
+ * buffer is full, the record of the cycle is dropped and counted, see getOverflows().
+ *
+ * The file starts with a header listing the channels, followed by one record per cycle
+ * holding the cycle number and the timestamp and value of every channel in the order in which
+ * the channels were added. Values are stored in the byte order of the machine.
+ *
+ * @since v1.3
+ */
+class SignalRecorder : public Block {
+ public:
+  /**
+   * Constructs a recorder.
+   *
+   * @param capacity - number of records which the buffer holds until they are written
+   */
+  SignalRecorder(std::size_t capacity = 1024);
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  SignalRecorder(const SignalRecorder&) = delete;
+
+  /**
+   * Destructor, stops recording.
+   */
+  virtual ~SignalRecorder();
+
+  /**
+   * Adds a channel recording the signal of an output.
+   * Has to be called before recording starts.
+   *
+   * @param output - output delivering the signal
+   * @param name - name of the channel
+   */
+  template < typename T >
+  void add(Output<T>& output, std::string name) {
+    add(output, name, false);
+  }
+
+  /**
+   * Adds a channel for every PeripheralInput in a time domain, named by the id of its HAL input.
+   * Has to be called before recording starts.
+   *
+   * @param td - time domain
+   */
+  void addPeripheralInputs(TimeDomain& td);
+
+  const std::vector<RecordChannel>& getChannels() const;
+
+  /**
+   * Opens the file, writes the header and starts recording with the next cycle.
+   *
+   * @param fileName - name of the file, an existing file is overwritten
+   */
+  void start(std::string fileName);
+
+  /**
+   * Stops recording, writes all buffered records and closes the file.
+   */
+  void stop();
+
+  bool isRecording() const;
+
+  /**
+   * Gets the number of records written to the file.
+   *
+   * @return number of records
+   */
+  uint64_t getNofRecords() const;
+
+  /**
+   * Gets the number of records which were dropped because the buffer was full.
+   *
+   * @return number of dropped records
+   */
+  uint64_t getOverflows() const;
+
+  virtual void run();
+
+  /**
+   * Registers a peripheral input for addPeripheralInputs(), called by PeripheralInput.
+   */
+  template < typename T >
+  static void registerPeripheral(Output<T>& output, std::string id) {
+    peripherals().push_back({output.getOwner(), &output, id, &addPeripheral<T>});
+  }
+
+  static void unregisterPeripheral(Block* block);
+
+ private:
+  struct Channel {
+    RecordChannel info;
+    const void* signal;
+    void (*capture)(const void* signal, uint8_t* dst);
+    std::unique_ptr<InputInterface> input;
+  };
+  struct Peripheral {
+    Block* block;
+    void* output;
+    std::string id;
+    void (*add)(SignalRecorder& recorder, void* output, const std::string& id);
+  };
+
+  template < typename T >
+  void add(Output<T>& output, std::string name, bool peripheral) {
+    static_assert(std::is_trivially_copyable<T>::value, "only signals of trivially copyable types can be recorded");
+    if (isRecording()) throw Fault("channel '" + name + "' can not be added while recording");
+    auto input = new Input<T>(this);
+    input->connect(output);
+    channels.push_back({{name, RecordTypeOf<T>::value, sizeof(T), peripheral}, &output.getSignal(), &capture<T>, std::unique_ptr<InputInterface>(input)});
+    infos.push_back(channels.back().info);
+  }
+
+  template < typename T >
+  static void addPeripheral(SignalRecorder& recorder, void* output, const std::string& id) {
+    recorder.add(*static_cast<Output<T>*>(output), id, true);
+  }
+
+  template < typename T >
+  static void capture(const void* signal, uint8_t* dst) {
+    auto s = static_cast<const Signal<T>*>(signal);
+    timestamp_t timestamp = s->getTimestamp();
+    T value = s->getValue();
+    std::memcpy(dst, &timestamp, sizeof(timestamp));
+    std::memcpy(dst + sizeof(timestamp), &value, sizeof(T));
+  }
+
+  static std::vector<Peripheral>& peripherals();
+  void run_writer();
+
+  std::vector<Channel> channels;
+  std::vector<RecordChannel> infos;
+  std::size_t capacity;
+  std::size_t recordSize;
+  std::unique_ptr<uint8_t[]> buffer;
+  std::atomic<uint64_t> head;
+  char pad0[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> tail;
+  char pad1[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> overflows;
+  std::atomic<bool> recording;
+  uint64_t cycle;
+  std::ofstream file;
+  std::thread writer;
+  logger::Logger log;
+};
+
+/**
+ * Replays a file written by SignalRecorder. The recorded channels are installed as inputs
+ * of the HAL with the names of the channels, so the PeripheralInput blocks of a time domain
+ * read the recorded values and timestamps instead of the hardware. Every call of get() of
+ * such an input returns the next record, as PeripheralInput calls it once per cycle.
+ * The inputs have to be installed before the PeripheralInput blocks are constructed and
+ * the replay has to outlive them. The whole file is read into memory on construction.
+ * Together with the virtual time of the executor, see Executor::setVirtualTime(), a time
+ * domain is run offline with the same inputs in every cycle and faster than realtime.
+ * Recording its signals again yields the same records.
+ *
+ * @since v1.3
+ */
+class SignalReplay {
+ public:
+  /**
+   * Reads a recorded file.
+   *
+   * @param fileName - name of the file
+   */
+  SignalReplay(std::string fileName);
+
+  /**
+   * Disabling use of copy constructor because the installed inputs refer to the replay.
+   */
+  SignalReplay(const SignalReplay&) = delete;
+
+  const std::vector<RecordChannel>& getChannels() const;
+
+  /**
+   * Gets the number of records read from the file.
+   *
+   * @return number of records
+   */
+  uint64_t getNofRecords() const;
+
+  /**
+   * Gets the number of records which are missing in the file because they were
+   * dropped while recording.
+   *
+   * @return number of missing records
+   */
+  uint64_t getMissingRecords() const;
+
+  /**
+   * Installs a HAL input for every recorded peripheral input of a plain number type.
+   */
+  void install();
+
+  /**
+   * Installs a HAL input for a recorded channel, e.g. a channel of a matrix type.
+   *
+   * @param name - name of the channel
+   * @return installed input
+   */
+  template < typename T >
+  hal::Input<T>* install(std::string name) {
+    static_assert(std::is_trivially_copyable<T>::value, "only signals of trivially copyable types can be replayed");
+    std::size_t i = find(name, sizeof(T));
+    auto input = new ReplayInput<T>(name, *this, offsets[i]);
+    inputs.emplace_back(input);
+    cursors.push_back(input);
+    add(input);
+    return input;
+  }
+
+  /**
+   * Checks whether all installed inputs have returned every record. Afterwards,
+   * the inputs keep returning the last record.
+   *
+   * @return true if the replay is finished
+   */
+  bool isFinished() const;
+
+ private:
+  struct Cursor {
+    std::atomic<uint64_t> next{0};
+  };
+
+  template < typename T >
+  class ReplayInput : public hal::Input<T>, public Cursor {
+   public:
+    ReplayInput(std::string id, const SignalReplay& replay, std::size_t offset)
+        : hal::Input<T>(id, nullptr), replay(replay), offset(offset), timestamp(0) { }
+    virtual T get() {
+      uint64_t n = next.load(std::memory_order_relaxed);
+      const uint8_t* src = replay.record(n) + offset;
+      if (n < replay.nofRecords) next.store(n + 1, std::memory_order_relaxed);
+      T value;
+      std::memcpy(&timestamp, src, sizeof(timestamp));
+      std::memcpy(&value, src + sizeof(timestamp), sizeof(T));
+      return value;
+    }
+    virtual uint64_t getTimestamp() { return timestamp; }
+   private:
+    const SignalReplay& replay;
+    std::size_t offset;
+    uint64_t timestamp;
+  };
+
+  std::size_t find(const std::string& name, std::size_t size) const;
+  const uint8_t* record(uint64_t n) const;
+  void add(hal::InputInterface* input);
+
+  std::vector<RecordChannel> channels;
+  std::vector<std::size_t> offsets;
+  std::size_t recordSize;
+  uint64_t nofRecords;
+  uint64_t missing;
+  std::vector<uint8_t> data;
+  std::vector<std::unique_ptr<hal::InputInterface>> inputs;
+  std::vector<Cursor*> cursors;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_SIGNALRECORDER_HPP_ */
@@ -4,7 +4,7 @@
 #include <eeros/control/Block1i1o.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <array>
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 #include <eeros/sockets/SocketServer.hpp>
 #include <eeros/sockets/SocketClient.hpp>
 
@@ -85,7 +85,7 @@ class SocketData<SigInType, SigOutType,
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -175,7 +175,7 @@ public:
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -240,7 +240,7 @@ public:
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -305,7 +305,7 @@ public:
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -403,7 +403,7 @@ public:
     }
             
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -500,7 +500,7 @@ public:
     }
             
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = CycleTime::now();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -3,6 +3,7 @@
 
 #include <eeros/control/Block1o.hpp>
 #include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 
 namespace eeros {
 namespace control {
@@ -61,7 +62,7 @@ class Step : public Block1o<T> {
       this->out.getSignal().setValue(initValue + stepHeight);
       stepDone = true;
     }
-    this->out.getSignal().setTimestamp(System::getTimeNs());
+    this->out.getSignal().setTimestamp(CycleTime::now());
   }
   
   /**
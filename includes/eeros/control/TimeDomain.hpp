@@ -2,8 +2,13 @@
 #define ORG_EEROS_CONTROLTIMEDOMAIN_HPP
 
 #include <list>
+#include <memory>
+#include <vector>
 #include <string>
 #include <eeros/core/Runnable.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/task/Parallel.hpp>
+#include <eeros/logger/Logger.hpp>
 #include <eeros/control/NotConnectedFault.hpp>
 #include <eeros/control/NaNOutputFault.hpp>
 #include <eeros/safety/SafetySystem.hpp>
@@ -14,6 +19,20 @@ namespace eeros {
 
 		using namespace safety;
 
+		/**
+		 * Execution times of a block as measured by the profiler of a time domain, in seconds.
+		 * 
+		 * @since v1.3
+		 */
+		struct BlockProfile {
+			std::string name;
+			uint64_t count;
+			double min;
+			double mean;
+			double max;
+			double p99;
+		};
+
 		class TimeDomain : public virtual Runnable {
 		public:
 			TimeDomain(std::string name, double period, bool realtime);
@@ -25,8 +44,105 @@ namespace eeros {
 			std::string getName();
 			double getPeriod();
 			bool getRealtime();
+
+			/**
+			 * Gets the blocks of this time domain in the order in which they were added.
+			 * 
+			 * @return blocks
+			 * @since v1.3
+			 */
+			const std::list<Runnable*>& getBlocks();
 			void registerSafetyEvent(SafetySystem& ss, SafetyEvent& e);
 
+			/**
+			 * Sorts the blocks of this time domain by their data dependencies and freezes 
+			 * the resulting order into a contiguous schedule which is then used by run().
+			 * A block is run after all blocks delivering signals to its inputs. Blocks without 
+			 * dependencies between each other keep the order in which they were added. 
+			 * Algebraic loops are reported, the blocks of such a loop are run in the 
+			 * order in which they were added. Unconnected inputs are reported as well, 
+			 * reading from them while running still raises a NotConnectedFault. 
+			 * Adding or removing blocks discards the schedule. The executor compiles all 
+			 * time domains before it starts running.
+			 * 
+			 * @return true, if no algebraic loop was found
+			 */
+			virtual bool compile();
+			bool isCompiled();
+
+			/**
+			 * Enables parallel execution of this time domain. When compiling, the blocks are split into 
+			 * subgraphs which do not exchange any signals. These subgraphs are distributed onto the chosen 
+			 * number of threads. The thread running the time domain runs the first partition, the others are 
+			 * run by worker threads which adopt its priority. All partitions have finished when run() returns, 
+			 * so the outputs are the same as with serial execution. 
+			 * Runnables which are not blocks are regarded as independent of all other blocks.
+			 * Has to be called before the time domain is compiled.
+			 * 
+			 * @param nofThreads - number of threads including the thread running the time domain, 1 disables parallel execution
+			 * @param cpus - cores to which the worker threads are pinned, empty for no pinning
+			 * @param spinCount - number of iterations a worker spins while waiting before it sleeps
+			 */
+			void setParallel(unsigned nofThreads, std::vector<int> cpus = {}, unsigned spinCount = 10000);
+
+			/**
+			 * Gets the number of partitions which are run in parallel.
+			 * 
+			 * @return number of partitions, 1 if the time domain runs serially
+			 */
+			std::size_t getNofPartitions();
+
+			/**
+			 * Gets the cores to which the worker threads are pinned, see setParallel().
+			 * 
+			 * @return cores, empty for no pinning
+			 */
+			std::vector<int> getParallelCpus();
+
+			/**
+			 * Enables or disables measuring the execution time of every block. Every block of the 
+			 * compiled schedule is wrapped into a runnable which reads the monotonic clock before 
+			 * and after running the block and adds the difference to a histogram of its own. 
+			 * When disabled, the schedule contains the blocks themselves and nothing is measured.
+			 * Has to be called before the time domain is compiled.
+			 * 
+			 * @param enabled - true to measure the blocks
+			 */
+			void setProfiling(bool enabled);
+			bool getProfiling();
+
+			/**
+			 * Gets the execution times of all blocks measured so far, sorted by the mean 
+			 * execution time with the most expensive block first. Allocates memory and is 
+			 * meant to be called by a non realtime thread.
+			 * 
+			 * @return profiles of the blocks, empty if profiling is disabled or the time domain is not compiled
+			 */
+			std::vector<BlockProfile> getProfile();
+
+			/**
+			 * Discards all execution times measured so far.
+			 */
+			void resetProfile();
+
+			/**
+			 * Logs the execution times of the blocks with the highest mean execution time.
+			 * 
+			 * @param count - maximum number of blocks to log
+			 */
+			void logProfile(std::size_t count = 10);
+
+			/**
+			 * Enables or disables the cycle time. When enabled, the clock is read once at the 
+			 * start of every cycle and the blocks stamp their outputs with this time, see CycleTime. 
+			 * When disabled, every block reads the clock on its own. Enabled by default.
+			 * 
+			 * @param enabled - true to use one timestamp per cycle
+			 * @since v1.3
+			 */
+			void setCycleTime(bool enabled);
+			bool getCycleTime();
+
 			virtual void run();
 			virtual void start();
 			virtual void stop();
@@ -34,11 +150,30 @@ namespace eeros {
 			friend std::ostream& operator<<(std::ostream& os, TimeDomain& td);
 			
 		private:
+			class ProfiledBlock : public Runnable {
+			public:
+				ProfiledBlock(Runnable* block) : block(block) { }
+				virtual void run();
+				Runnable* block;
+				Histogram histogram;	// execution time in nanoseconds
+			};
+
 			std::string name;
 			double period;
 			bool realtime;
 			bool running = true;
 			std::list<Runnable*> blocks;
+			std::vector<Runnable*> schedule;
+			std::vector<std::string> scheduleNames;	// names of the scheduled blocks for tracing and RealtimeCheck
+			bool compiled = false;
+			unsigned nofThreads = 1;
+			std::vector<int> cpus;
+			unsigned spinCount = 10000;
+			std::unique_ptr<task::Parallel> parallel;
+			bool profiling = false;
+			std::vector<std::unique_ptr<ProfiledBlock>> profiled;
+			bool cycleTime = true;
+			logger::Logger log;
 			SafetySystem* safetySystem;
 			SafetyEvent* safetyEvent;
 		};
@@ -1,146 +1,277 @@
-#ifndef ORG_EEROS_CONTROL_TRANSITION_HPP_
-#define ORG_EEROS_CONTROL_TRANSITION_HPP_
-
-#include <mutex>
-#include <eeros/control/Block1i.hpp>
-#include <eeros/control/Block1o.hpp>
-#include <eeros/control/Block1i1o.hpp>
-#include <iostream>
-namespace eeros {
-	namespace control {
-		
-		template < typename T > class Transition;
-		
-		template < typename T = double >
-		class TransitionInBlock : public Block1i<T> {
-		public:
-			TransitionInBlock(Transition<T>* c) : container(c) { }
-			virtual ~TransitionInBlock() { }
-			
-			virtual void run() { 
-				if (container->steady) {
-					container->mtx.lock();
-					container->in = this->getIn().getSignal(); 
-					container->mtx.unlock();
-// 					std::cout << " do in: " << this->getIn().getSignal().getTimestamp() << std::endl;
-				} else {
-					if (up) {	// up
-						container->mtx.lock();
-						container->prevIn = container->in;
-						container->in = this->getIn().getSignal(); 
-						container->refresh = true;
-						container->mtx.unlock();
-					} else {	//down
-						container->mtx.lock();
-						auto val = this->getIn().getSignal(); 
-						container->buf.push_back(val);
-						container->mtx.unlock();
-					}
-				}
-			}
-			
-			bool up;
-
-		protected:
-			Transition<T>* container;
-		};
-		
-		template < typename T = double >
-		class TransitionOutBlock : public Block1i1o<T> {
-		public:
-			TransitionOutBlock(Transition<T>* c) : container(c), count(0) {in.clear(); prevIn.clear();}
-			virtual ~TransitionOutBlock() { }
-			
-			virtual void run() { 
-				if (container->steady) {
-					container->mtx.lock();
-					this->getOut().getSignal().setValue(container->in.getValue()); 
-					this->getOut().getSignal().setTimestamp(container->in.getTimestamp());
-					container->mtx.unlock();
-// 					std::cout << " do out" << std::endl;
-				} else {
-					if (up) {	// up
-						if (container->refresh) {
-							container->mtx.lock();
-							prevIn = container->prevIn;
-							in = container->in;
-							container->refresh = false;
-							container->mtx.unlock();
-							count = 0;
-							dVal = (in.getValue() - prevIn.getValue()) / container->ratio;
-							dTime= (in.getTimestamp() - prevIn.getTimestamp()) / container->ratio;
-						}
-						T val = prevIn.getValue() + dVal * count;
-						this->getOut().getSignal().setValue(val);
-						timestamp_t time = prevIn.getTimestamp() + count * dTime;
-						this->getOut().getSignal().setTimestamp(time);
-						count++;
-					} else {	//down
-						auto time = this->getIn().getSignal().getTimestamp();
-						container->mtx.lock();
-						std::size_t i = 0;
-						while (i < container->buf.size() && time > container->buf[i].getTimestamp()) i++;
-						if (i > 0) i--;
-						Signal<T> sig = container->buf[i];
-						container->buf.clear();
-						container->mtx.unlock();
-						this->getOut().getSignal().setValue(sig.getValue());
-						this->getOut().getSignal().setTimestamp(sig.getTimestamp());
-					}
-				}
-			}
-			
-			bool up;
-
-		protected:
-			Transition<T>* container;
-			Signal<T> prevIn, in;
-			T dVal;
-			double dTime;
-			uint32_t count;
-		};
-
-		template < typename T = double >
-		class Transition {
-		friend class TransitionInBlock<T>;
-		friend class TransitionOutBlock<T>;
-		public:
-			Transition(double ratio, bool steady = false) : inBlock(this), outBlock(this), steady(steady), ratio(ratio) {
-				if (ratio >= 1.0) {	// slow to fast time domain
-					inBlock.up = true;
-					outBlock.up = true;
-					refresh = false;
-					in.clear(); 
-					prevIn.clear();
-				} else {	// fast to slow time domain
-					inBlock.up = false;
-					outBlock.up = false;
-					bufSize = 1 / ratio;
-				}
-			}
-			virtual ~Transition() { }
-			
-			TransitionInBlock<T> inBlock;
-			TransitionOutBlock<T> outBlock;
-			
-		private: 
-			std::vector<Signal<T>> buf;
-			Signal<T> in, prevIn;
-			bool refresh;
-			bool steady;
-			double ratio;
-			uint32_t bufSize;
-			std::mutex mtx;
-		};
-
-		/********** Print functions **********/
-		template <typename T>
-		std::ostream& operator<<(std::ostream& os, Transition<T>& t) {
-			os << "Block transition: '" << t.getName() << "'"; 
-            return os;
-		}
-
-	};
-};
-
-#endif /* ORG_EEROS_CONTROL_TRANSITION_HPP_ */
\ No newline at end of file
+#ifndef ORG_EEROS_CONTROL_TRANSITION_HPP_
+#define ORG_EEROS_CONTROL_TRANSITION_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <eeros/control/Block1i.hpp>
+#include <eeros/control/Block1o.hpp>
+#include <eeros/control/Block1i1o.hpp>
+#include <eeros/core/RingBuffer.hpp>
+#include <iostream>
+namespace eeros {
+	namespace control {
+
+		/**
+		 * Value and timestamp of a signal as it is passed between two time domains.
+		 * Unlike a signal it carries no name and no id and can be copied without allocating memory.
+		 *
+		 * @since v1.3
+		 */
+		template < typename T >
+		struct TransitionSample {
+			T value;
+			timestamp_t timestamp;
+
+			static TransitionSample cleared() {
+				Signal<T> s;
+				s.clear();
+				return {s.getValue(), s.getTimestamp()};
+			}
+		};
+
+		/**
+		 * Lock-free triple buffer which passes the latest value from one producer thread
+		 * to one consumer thread. Neither side ever blocks or waits for the other side.
+		 * The producer writes into writeBuffer() and calls publish(), the consumer calls
+		 * update() and reads readBuffer(), which stays valid until the next call of update().
+		 *
+		 * @since v1.3
+		 */
+		template < typename T >
+		class TransitionBuffer {
+		public:
+			TransitionBuffer(const T& init) : back(0), middle(1), front(2) {
+				for (auto& s : slots) s = init;
+			}
+
+			T& writeBuffer() { return slots[back]; }
+
+			void publish() {
+				back = middle.exchange(back | fresh, std::memory_order_acq_rel) & index;
+			}
+
+			/**
+			 * Makes the latest published value available in readBuffer().
+			 *
+			 * @return true if a new value was published since the last call
+			 */
+			bool update() {
+				if ((middle.load(std::memory_order_relaxed) & fresh) == 0) return false;
+				front = middle.exchange(front, std::memory_order_acq_rel) & index;
+				return true;
+			}
+
+			const T& readBuffer() const { return slots[front]; }
+
+		private:
+			static constexpr unsigned index = 0x3;
+			static constexpr unsigned fresh = 0x4;
+			T slots[3];
+			unsigned back;
+			std::atomic<unsigned> middle;
+			unsigned front;
+		};
+
+		/**
+		 * Lock-free ring buffer with a fixed capacity for one producer and one consumer thread.
+		 * All memory is allocated on construction. If the buffer is full, push() drops the new
+		 * element and counts it as overflow.
+		 *
+		 * @since v1.3
+		 */
+		template < typename T >
+		class TransitionQueue {
+		public:
+			/**
+			 * Constructs a queue which holds at least the given number of elements.
+			 *
+			 * @param size - minimum capacity, rounded up to the next power of two
+			 */
+			TransitionQueue(std::size_t size) : items(detail::nextPowerOfTwo(std::max<std::size_t>(size, 2))), overflows(0) { }
+
+			bool push(const T& v) {
+				if (items.push(v)) return true;
+				overflows.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			bool pop(T& v) {
+				return items.pop(v);
+			}
+
+			std::size_t capacity() const { return items.size(); }
+
+			uint64_t getOverflows() const { return overflows.load(std::memory_order_relaxed); }
+
+		private:
+			SpscRingBuffer<T, 0> items;
+			std::atomic<uint64_t> overflows;
+		};
+
+		template < typename T > class Transition;
+
+		template < typename T = double >
+		class TransitionInBlock : public Block1i<T> {
+		public:
+			TransitionInBlock(Transition<T>* c) : container(c), prevIn(TransitionSample<T>::cleared()) { }
+			virtual ~TransitionInBlock() { }
+
+			virtual void run() {
+				auto& sig = this->getIn().getSignal();
+				if (container->steady) {
+					auto& s = container->latest.writeBuffer();
+					s.value = sig.getValue();
+					s.timestamp = sig.getTimestamp();
+					container->latest.publish();
+				} else {
+					if (up) {	// up
+						auto& s = container->pair.writeBuffer();
+						s.prevIn = prevIn;
+						s.in.value = sig.getValue();
+						s.in.timestamp = sig.getTimestamp();
+						container->pair.publish();
+						prevIn = s.in;
+					} else {	//down
+						container->samples.push({sig.getValue(), sig.getTimestamp()});
+					}
+				}
+			}
+
+			bool up;
+
+		protected:
+			Transition<T>* container;
+			TransitionSample<T> prevIn;
+		};
+
+		template < typename T = double >
+		class TransitionOutBlock : public Block1i1o<T> {
+		public:
+			TransitionOutBlock(Transition<T>* c) : container(c), count(0) {in.clear(); prevIn.clear();}
+			virtual ~TransitionOutBlock() { }
+
+			virtual void run() {
+				if (container->steady) {
+					container->latest.update();
+					auto& s = container->latest.readBuffer();
+					this->getOut().getSignal().setValue(s.value);
+					this->getOut().getSignal().setTimestamp(s.timestamp);
+				} else {
+					if (up) {	// up
+						if (container->pair.update()) {
+							auto& s = container->pair.readBuffer();
+							prevIn.setValue(s.prevIn.value);
+							prevIn.setTimestamp(s.prevIn.timestamp);
+							in.setValue(s.in.value);
+							in.setTimestamp(s.in.timestamp);
+							count = 0;
+							dVal = (in.getValue() - prevIn.getValue()) / container->ratio;
+							dTime= (in.getTimestamp() - prevIn.getTimestamp()) / container->ratio;
+						}
+						T val = prevIn.getValue() + dVal * count;
+						this->getOut().getSignal().setValue(val);
+						timestamp_t time = prevIn.getTimestamp() + count * dTime;
+						this->getOut().getSignal().setTimestamp(time);
+						count++;
+					} else {	//down
+						// take the last sample captured before the timestamp of the input,
+						// or the first one if all of them are newer
+						auto time = this->getIn().getSignal().getTimestamp();
+						TransitionSample<T> s;
+						bool found = false;
+						while (container->samples.pop(s)) {
+							if (!found || s.timestamp < time) {
+								this->getOut().getSignal().setValue(s.value);
+								this->getOut().getSignal().setTimestamp(s.timestamp);
+								found = true;
+							}
+						}
+					}
+				}
+			}
+
+			bool up;
+
+		protected:
+			Transition<T>* container;
+			Signal<T> prevIn, in;
+			T dVal;
+			double dTime;
+			uint32_t count;
+		};
+
+		/**
+		 * A transition passes a signal from one time domain to another time domain, which
+		 * runs in a different thread. The ratio is the period of the sending time domain
+		 * divided by the period of the receiving time domain.
+		 * The signal is passed lock-free and without allocating memory. From a fast to a slow
+		 * time domain the samples are queued in a ring buffer which can hold the samples of
+		 * four periods of the slow time domain. Samples which do not fit are dropped
+		 * and counted, see getOverflows().
+		 */
+		template < typename T = double >
+		class Transition {
+		friend class TransitionInBlock<T>;
+		friend class TransitionOutBlock<T>;
+		public:
+			Transition(double ratio, bool steady = false)
+				: inBlock(this), outBlock(this), steady(steady), ratio(ratio),
+				  latest(TransitionSample<T>::cleared()),
+				  pair({TransitionSample<T>::cleared(), TransitionSample<T>::cleared()}), samples(queueSize(ratio)) {
+				if (ratio >= 1.0) {	// slow to fast time domain
+					inBlock.up = true;
+					outBlock.up = true;
+				} else {	// fast to slow time domain
+					inBlock.up = false;
+					outBlock.up = false;
+				}
+			}
+			virtual ~Transition() { }
+
+			/**
+			 * Gets the number of samples which were dropped because the receiving
+			 * time domain did not fetch them in time.
+			 *
+			 * @return number of dropped samples
+			 * @since v1.3
+			 */
+			uint64_t getOverflows() const {
+				return samples.getOverflows();
+			}
+
+			TransitionInBlock<T> inBlock;
+			TransitionOutBlock<T> outBlock;
+
+		private:
+			struct Pair {
+				TransitionSample<T> prevIn, in;
+			};
+
+			static std::size_t queueSize(double ratio) {
+				const double maxSamples = 4096;
+				if (ratio >= 1.0) return 2;
+				double n = (ratio > 0) ? std::ceil(1 / ratio) : maxSamples;
+				return 4 * static_cast<std::size_t>(std::min(n, maxSamples));
+			}
+
+			bool steady;
+			double ratio;
+			TransitionBuffer<TransitionSample<T>> latest;
+			TransitionBuffer<Pair> pair;
+			TransitionQueue<TransitionSample<T>> samples;
+		};
+
+		/********** Print functions **********/
+		template <typename T>
+		std::ostream& operator<<(std::ostream& os, Transition<T>& t) {
+			os << "Block transition: '" << t.getName() << "'";
+            return os;
+		}
+
+	};
+};
+
+#endif /* ORG_EEROS_CONTROL_TRANSITION_HPP_ */
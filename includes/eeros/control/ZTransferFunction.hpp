@@ -1,7 +1,7 @@
 #ifndef ORG_EEROS_CONTROL_ZTRANSFERFUNCTION_HPP_
 #define ORG_EEROS_CONTROL_ZTRANSFERFUNCTION_HPP_
 
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 #include <eeros/control/Block1i1o.hpp>
 #include <eeros/math/Fraction.hpp>
 #include <vector>
@@ -67,7 +67,7 @@ namespace eeros {
 					last_out[0] /= fraction.denominator.c[0];
 					
 					out.getSignal().setValue(last_out[0]);
-					out.getSignal().setTimestamp(eeros::System::getTimeNs());
+					out.getSignal().setTimestamp(eeros::CycleTime::now());
 					
 					for (int i = (N - 1); i >= 0; i--) {
 						last_in[i] = last_in[i - 1];
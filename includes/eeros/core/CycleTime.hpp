@@ -0,0 +1,67 @@
+#ifndef ORG_EEROS_CORE_CYCLETIME_HPP_
+#define ORG_EEROS_CORE_CYCLETIME_HPP_
+
+#include <cstdint>
+#include <eeros/core/System.hpp>
+
+namespace eeros {
+
+/**
+ * Time of the cycle which the calling thread is running. A time domain reads the clock once 
+ * when it starts a cycle, all blocks of the cycle stamp their outputs with this time, so the 
+ * outputs of a cycle have consistent timestamps. Outside of a cycle, the time of the system is 
+ * used, see System::getTimeNs(). 
+ * Blocks whose samples have to be timed on their own read the clock themselves, e.g. a HAL input 
+ * which delivers the timestamps of the hardware, see hal::Input::getTimestamp().
+ *
+ * @since v1.3
+ */
+class CycleTime {
+ public:
+  static constexpr uint64_t unset = ~static_cast<uint64_t>(0);
+
+  /**
+   * Gets the time of the current cycle.
+   *
+   * @return time in nanoseconds, the time of the system if no cycle is running
+   */
+  static uint64_t now() {
+    return (current != unset) ? current : System::getTimeNs();
+  }
+
+  /**
+   * Gets the time of the current cycle, e.g. to pass it on to other threads running parts of the cycle.
+   *
+   * @return time in nanoseconds, unset if no cycle is running
+   */
+  static uint64_t get() {
+    return current;
+  }
+
+  /**
+   * Sets the time of the cycle of the calling thread while the scope exists. 
+   * Scopes can be nested, the previous time is restored at the end of a scope.
+   */
+  class Scope {
+   public:
+    /**
+     * @param time - time of the cycle in nanoseconds, unset to read the clock on every call of now()
+     */
+    explicit Scope(uint64_t time) : previous(current) {
+      current = time;
+    }
+    ~Scope() {
+      current = previous;
+    }
+   private:
+    uint64_t previous;
+  };
+
+ private:
+  CycleTime();
+  static thread_local uint64_t current;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_CYCLETIME_HPP_
@@ -0,0 +1,82 @@
+#ifndef ORG_EEROS_CORE_CYCLETIMER_HPP_
+#define ORG_EEROS_CORE_CYCLETIMER_HPP_
+
+#include <stdint.h>
+#include <time.h>
+
+namespace eeros {
+
+/**
+ * A cycle timer keeps the deadlines of a periodic loop as absolute time in integer 
+ * nanoseconds and sleeps with clock_nanosleep(TIMER_ABSTIME). Thereby the period does 
+ * not drift, regardless of how long the loop runs.
+ *
+ * @since v1.3
+ */
+class CycleTimer {
+ public:
+  /**
+   * Constructs a cycle timer.
+   *
+   * @param period - period in seconds
+   * @param clock - clock used for the deadlines, must be supported by clock_nanosleep
+   */
+  CycleTimer(double period, clockid_t clock = CLOCK_MONOTONIC);
+
+  /**
+   * Sets the first deadline one period from now.
+   */
+  void start();
+
+  /**
+   * Sleeps until the current deadline has been reached.
+   */
+  void sleep();
+
+  /**
+   * Moves the deadline one period ahead.
+   *
+   * @return number of deadlines which have already passed, 0 if the loop is on time
+   */
+  uint64_t next();
+
+  /**
+   * Skips a given number of deadlines.
+   *
+   * @param cycles - number of deadlines to skip
+   */
+  void skip(uint64_t cycles);
+
+  /**
+   * Gets the current deadline.
+   *
+   * @return deadline in nanoseconds
+   */
+  uint64_t getDeadline() const;
+
+  /**
+   * Gets the time by which the loop was late when next() was called last.
+   *
+   * @return time in nanoseconds after the deadline, 0 if the loop was on time
+   * @since v1.3
+   */
+  uint64_t getLateness() const;
+
+  /**
+   * Gets the period.
+   *
+   * @return period in nanoseconds
+   */
+  uint64_t getPeriod() const;
+
+ private:
+  uint64_t now() const;
+  clockid_t clock;
+  uint64_t period;
+  uint64_t deadline;
+  uint64_t lateness;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_CYCLETIMER_HPP_
@@ -1,10 +1,13 @@
 #ifndef ORG_EEROS_CORE_EXECUTOR_HPP_
 #define ORG_EEROS_CORE_EXECUTOR_HPP_
 
+#include <atomic>
 #include <vector>
+#include <string>
 #include <condition_variable>
 
 #include <eeros/core/Runnable.hpp>
+#include <eeros/core/OverrunPolicy.hpp>
 #include <eeros/core/PeriodicCounter.hpp>
 #include <eeros/task/Periodic.hpp>
 #include <eeros/logger/Logger.hpp>
@@ -26,8 +29,19 @@ namespace control {
 
 namespace safety {
   class SafetySystem;
+  class SafetyEvent;
 };
 
+/**
+ * Scheduling modes of the executor. In harmonic mode, the period of every periodic 
+ * must be a multiple of the period of the periodic it is based on. In rateMonotonic mode, 
+ * a periodic whose period is not such a multiple runs on a timer of its own, unless it is run 
+ * before or after another periodic, which is rejected like in harmonic mode. In both modes 
+ * the realtime priorities are assigned rate-monotonically, the shorter the period the higher 
+ * the priority.
+ */
+enum class SchedulingMode { harmonic, rateMonotonic };
+
 /**
  * The executor is responsible for running periodics, e.g. time domains.
  * You have to set one periodic as the main task. From its period all the other periodics
@@ -41,6 +55,12 @@ class Executor : public Runnable {
  public:
   virtual ~Executor();
   static Executor& instance();
+
+  /**
+   * Disabling use of copy constructor and assignment because there is a single executor only.
+   */
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
   
   /**
    * Set the main task.
@@ -63,14 +83,189 @@ class Executor : public Runnable {
    * @param period - period of the default main task
    */
   void setExecutorPeriod(double period);
+
+  /**
+   * Before the first cycle, the executor waits for all threads to be ready. 
+   * If not all threads are ready within this timeout, the executor does not start.
+   * The default value is 5 seconds.
+   * 
+   * @param timeout - maximum time in seconds to wait for all threads
+   */
+  void setStartupTimeout(double timeout);
+
+  /**
+   * Sets the cores on which the executor thread may run. This thread runs the main task 
+   * and all harmonic tasks with the base period.
+   * At startup, the cores of the executor and all periodics are checked against the cores 
+   * available to the process (e.g. a cgroup cpuset) and the isolated cores (isolcpus).
+   * 
+   * @param cpus - cores, an empty vector allows all cores
+   */
+  void setCpus(std::vector<int> cpus);
+
+  /**
+   * Sets the policy of the default executor loop in case a cycle overruns its deadline.
+   * Overruns are counted in the periodic counter of the executor. The default policy is catchUp.
+   * 
+   * @param policy - overrun policy
+   */
+  void setOverrunPolicy(OverrunPolicy policy);
+
+  /**
+   * Sets the overrun policy to triggerEvent. 
+   * 
+   * @param ss - safety system
+   * @param e - safety event which is triggered upon an overrun
+   */
+  void setOverrunPolicy(safety::SafetySystem &ss, safety::SafetyEvent &e);
+
+  /**
+   * Enables phase staggering of the periodics run by the executor thread. Periodics 
+   * with the same period are shifted against each other by whole base periods so that 
+   * their cycles do not all start with the same base period, see 
+   * task::HarmonicTaskList::stagger(). Periodics with a fixed phase are not moved. 
+   * At startup the phases are assigned from the expected run times of the periodics 
+   * (see task::Periodic::setRunTime(), periodics without are weighted with the mean of 
+   * the others). With a measuring time, the phases are assigned once more from the 
+   * measured mean run times after this time, by a thread without realtime priority, and the 
+   * executor thread applies them in one of the next cycles. The worst-case utilization of a 
+   * base period is logged each time.
+   * Only the periodics added to the executor are staggered, not the ones run before or after them.
+   * 
+   * @param enabled - true to assign phases automatically
+   * @param measuringTime - time in seconds after which the phases are reassigned from the measured run times, 0 for never
+   * @since v1.3
+   */
+  void setStaggering(bool enabled, double measuringTime = 0);
+
+  /**
+   * Sets the scheduling mode. In rateMonotonic mode the executor additionally analyses 
+   * the schedulability of its own thread and of all realtime threads at startup with the 
+   * expected run times of the periodics (see task::Periodic::setRunTime()) and, after 
+   * the measuring time, with the measured maximum run times, see Schedulability. 
+   * Threads pinned to the same cores are analysed together. The results are logged.
+   * The default mode is harmonic.
+   * 
+   * @param mode - scheduling mode
+   * @param measuringTime - time in seconds after which the measured run times are analysed, 0 for never
+   * @since v1.3
+   */
+  void setSchedulingMode(SchedulingMode mode, double measuringTime = 0);
+
+  /**
+   * Gets the worst-case utilization of a base period, that is the highest sum of the run times 
+   * of the main task and of the periodics starting in one base period divided by the base period, 
+   * as calculated when the phases were last assigned.
+   * 
+   * @return utilization, 0 if staggering is disabled
+   * @since v1.3
+   */
+  double getPeakUtilization();
+
+  /**
+   * Runs the executor in virtual time for simulation and testing. Instead of sleeping, 
+   * the executor advances the VirtualClock by exactly one base period per cycle and 
+   * runs the next cycle as soon as all periodics released in this cycle and all sequences 
+   * whose waiting time ended have finished. System::getTimeNs(), the timeouts and Wait 
+   * steps of sequences and the counters follow the virtual time, so a run yields the same 
+   * results on every machine and runs as fast as the computations allow. 
+   * The virtual clock starts at 0 and stands still from this call until run(), so this 
+   * has to be called before any sequence is started. After run() returns, the clock of 
+   * the system is used again. 
+   * Periodics with a timer of their own (see setSchedulingMode()) and syncing with 
+   * EtherCAT or ROS are not supported in virtual time.
+   * 
+   * @param enabled - true to run in virtual time
+   * @since v1.3
+   */
+  void setVirtualTime(bool enabled);
+
+  /**
+   * Periodically writes percentiles of period, jitter and run time of the executor and of
+   * all threads, see PeriodicCounter::dump(). The dump is written by a separate thread
+   * without realtime priority, the realtime threads do not allocate any memory for it.
+   *
+   * @param interval - interval in seconds, 0 disables the dump
+   * @param fileName - file to which the dump is appended, the logger is used if empty
+   * @since v1.3
+   */
+  void setCounterDump(double interval, std::string fileName = "");
+
+  /**
+   * Sets how much of the stack of the executor thread is prefaulted at startup, see 
+   * prefault_stack(). The executor runs in the thread calling run(), usually the main thread, 
+   * whose stack grows on demand up to the limit set by ulimit -s. The stacks of the periodics 
+   * are prefaulted completely, see task::Periodic::setStackSize(). The default is 1 MiB.
+   * 
+   * @param size - number of bytes, 0 for the whole stack up to the limit
+   * @since v1.3
+   */
+  void setStackPrefault(std::size_t size);
+
+  /**
+   * Reserves memory on the heap at startup before any thread is created, see reserve_heap().
+   * With a single arena, the threads created afterwards allocate from the reserved memory too, 
+   * but all allocations of the whole process, including those of non realtime threads, 
+   * are then serialized on one lock.
+   * 
+   * @param size - number of bytes, 0 reserves nothing (default)
+   * @param singleArena - true to make all threads allocate from the same arena
+   * @since v1.3
+   */
+  void setHeapReserve(std::size_t size, bool singleArena = false);
+
   task::Periodic* getMainTask();
   void add(task::Periodic &task);
   void add(control::TimeDomain &timedomain);
   virtual void run();
 
-  static void prefault_stack();
+  /**
+   * Fills the stack of the calling thread below the current frame with a pattern, so that its 
+   * pages are mapped before the first cycle and locked by lock_memory(). The pattern is used 
+   * to measure the stack usage, see get_stack_high_water().
+   * 
+   * @param size - number of bytes, 0 for the whole stack
+   */
+  static void prefault_stack(std::size_t size = 0);
+
+  /**
+   * Gets the maximum stack usage of the calling thread, measured from the top of its stack 
+   * to the lowest address whose pattern written by prefault_stack() was overwritten. 
+   * If the usage exceeded the prefaulted part, the size of the prefaulted part is returned.
+   * 
+   * @return number of bytes, 0 if the stack of the calling thread was not prefaulted
+   * @since v1.3
+   */
+  static std::size_t get_stack_high_water();
+
+  /**
+   * Gets the size of the stack of the calling thread.
+   * 
+   * @return number of bytes
+   * @since v1.3
+   */
+  static std::size_t get_stack_size();
+
+  /**
+   * Reserves memory on the heap which is kept for later allocations. Trimming the heap and 
+   * allocating large blocks with mmap() are disabled, then the given number of bytes is 
+   * allocated, touched and freed. Together with lock_memory(), allocations up to this size 
+   * do not cause page faults any more. 
+   * The memory is reserved in the arena of the calling thread, other threads may allocate 
+   * from arenas of their own. With a single arena (M_ARENA_MAX 1), all threads allocate from 
+   * the reserved memory, at the cost of serializing the allocations of the whole process.
+   * 
+   * @param size - number of bytes
+   * @param singleArena - true to make all threads allocate from the same arena
+   * @return true on success
+   * @since v1.3
+   */
+  static bool reserve_heap(std::size_t size, bool singleArena = false);
   static bool lock_memory();
   static bool set_priority(int nice);
+  static bool set_affinity(const std::vector<int> &cpus);
+  static std::vector<int> get_affinity();
+  static std::string cpu_list(const std::vector<int> &cpus);
   static void stop();
   static constexpr int basePriority = 49;
   PeriodicCounter counter;
@@ -86,9 +281,27 @@ class Executor : public Runnable {
  private:
   Executor();
   void assignPriorities();
+  void compileTimeDomains();
+  void checkCpus();
   double period;
+  double startupTimeout;
   task::Periodic* mainTask;
   std::vector<task::Periodic> tasks;
+  std::vector<int> cpus;
+  double dumpInterval;
+  std::string dumpFile;
+  std::size_t stackPrefault;
+  std::size_t heapReserve;
+  bool heapSingleArena;
+  SchedulingMode schedulingMode;
+  double schedulingMeasuringTime;
+  bool staggering;
+  double staggerMeasuringTime;
+  std::atomic<double> peakUtilization;  // written by the stagger thread
+  bool virtualTime;
+  OverrunPolicy overrunPolicy;
+  safety::SafetySystem* safetySystem;
+  safety::SafetyEvent* overrunEvent;
   bool syncWithEtherCatStackIsSet;
   bool syncWithRosTimeIsSet;
   bool syncWithRosTopicIsSet;
@@ -0,0 +1,96 @@
+#ifndef ORG_EEROS_CORE_HISTOGRAM_HPP_
+#define ORG_EEROS_CORE_HISTOGRAM_HPP_
+
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace eeros {
+
+/**
+ * A log-linear histogram of non-negative integer values, e.g. durations in nanoseconds.
+ * Every power of two is divided into 32 buckets of equal width, so the relative error
+ * of a percentile is below 3.2 % over the whole range. Values below 32 are counted exactly,
+ * values of 2^36 (about 69 seconds in nanoseconds) and above land in the last bucket.
+ *
+ * One thread adds values, any other thread can take a snapshot at any time.
+ * Adding a value is wait-free and never allocates memory.
+ *
+ * @since v1.3
+ */
+class Histogram {
+ public:
+  static constexpr unsigned subBucketBits = 5;
+  static constexpr unsigned rangeBits = 36;
+  static constexpr std::size_t nofSubBuckets = std::size_t(1) << subBucketBits;
+  static constexpr std::size_t nofBuckets = (rangeBits - subBucketBits + 1) * nofSubBuckets;
+
+  /**
+   * Copy of the counts of a histogram which can be evaluated without affecting the histogram.
+   */
+  struct Snapshot {
+    std::array<uint64_t, nofBuckets> buckets;
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+
+    /**
+     * Gets the value below which a given percentage of all values lie.
+     *
+     * @param percent - percentage, e.g. 99.9
+     * @return highest value of the bucket which contains the percentile, 0 if empty
+     */
+    uint64_t percentile(double percent) const;
+
+    /**
+     * Gets the mean of all values.
+     *
+     * @return mean, 0 if empty
+     */
+    double mean() const;
+  };
+
+  Histogram();
+
+  /**
+   * Adds a value. Must be called by one thread only.
+   *
+   * @param value - value to add
+   */
+  void add(uint64_t value);
+
+  /**
+   * Removes all values.
+   */
+  void reset();
+
+  /**
+   * Copies the current counts.
+   *
+   * @param snapshot - snapshot to fill
+   */
+  void snapshot(Snapshot& snapshot) const;
+
+  /**
+   * Replaces the counts by those of a snapshot. Must be called by the thread 
+   * which adds values.
+   *
+   * @param snapshot - snapshot to take the counts from
+   */
+  void restore(const Snapshot& snapshot);
+
+  static std::size_t bucket(uint64_t value);
+  static uint64_t lowerBound(std::size_t bucket);
+
+ private:
+  std::array<std::atomic<uint64_t>, nofBuckets> buckets;
+  std::atomic<uint64_t> min;
+  std::atomic<uint64_t> max;
+  std::atomic<uint64_t> sum;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_HISTOGRAM_HPP_
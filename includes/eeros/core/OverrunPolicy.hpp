@@ -0,0 +1,19 @@
+#ifndef ORG_EEROS_CORE_OVERRUNPOLICY_HPP_
+#define ORG_EEROS_CORE_OVERRUNPOLICY_HPP_
+
+namespace eeros {
+
+/**
+ * Policies in case a cycle overruns its deadline.
+ * catchUp runs the missed cycles back to back, skip drops the missed cycles and 
+ * continues with the next deadline in the future, coalesce runs all missed cycles 
+ * as one cycle right away, triggerEvent triggers a safety event and then drops 
+ * the missed cycles.
+ *
+ * @since v1.3
+ */
+enum class OverrunPolicy { catchUp, skip, coalesce, triggerEvent };
+
+}
+
+#endif // ORG_EEROS_CORE_OVERRUNPOLICY_HPP_
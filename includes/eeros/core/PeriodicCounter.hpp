@@ -1,11 +1,15 @@
 #ifndef ORG_EEROS_CORE_PERIODICCOUNTER_HPP_
 #define ORG_EEROS_CORE_PERIODICCOUNTER_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <vector>
 #include <functional>
+#include <cstdint>
+#include <ostream>
 
 #include <eeros/core/Statistics.hpp>
+#include <eeros/core/Histogram.hpp>
 #include <eeros/logger/Logger.hpp>
 
 namespace eeros {
@@ -19,6 +23,15 @@ class PeriodicCounter {
   using MonitorFunc = std::function<void(PeriodicCounter&, Logger&)>;
 
   PeriodicCounter(double period = 0, unsigned logger_category = 0);
+
+  /**
+   * Copies a counter. The histograms are copied from a snapshot, see snapshot(),
+   * so the counter to copy may be running.
+   *
+   * @param counter - counter to copy
+   */
+  PeriodicCounter(const PeriodicCounter &counter);
+  PeriodicCounter &operator=(const PeriodicCounter &counter);
   
   void setPeriod(double period);
   void setResetTime(double sec);
@@ -28,12 +41,55 @@ class PeriodicCounter {
   void tock();
   void reset();
 
+  /**
+   * Registers an overrun, that is, a cycle which did not finish before the next deadline.
+   *
+   * @param missed - number of deadlines which have passed
+   * @param lateness - time in seconds by which the cycle finished after its deadline
+   */
+  void overrun(uint64_t missed, double lateness = 0);
+
   void operator >> (logger::LogEntry &event);
   void operator >> (logger::LogEntry &&event);
 
+  /**
+   * Histograms of period, jitter and run time in nanoseconds as taken by snapshot().
+   * The jitter is the absolute deviation of the period from its nominal value.
+   *
+   * @since v1.3
+   */
+  struct Snapshot {
+    Histogram::Snapshot period;
+    Histogram::Snapshot jitter;
+    Histogram::Snapshot run;
+  };
+
+  /**
+   * Copies the histograms of period, jitter and run time. Can be called by any thread 
+   * while the counter is running, the three histograms always contain the same cycles.
+   * The realtime thread is never blocked, the copy is repeated if a cycle was added meanwhile.
+   *
+   * @param snapshot - snapshot to fill
+   * @since v1.3
+   */
+  void snapshot(Snapshot &snapshot) const;
+
+  /**
+   * Writes p50, p99, p99.9 and max of period, jitter and run time, one line each.
+   * Takes a snapshot first and is meant to be called by a non realtime thread.
+   *
+   * @param os - stream to write to
+   * @since v1.3
+   */
+  void dump(std::ostream &os) const;
+
   Statistics period;
   Statistics jitter;
   Statistics run;
+  // written by the realtime thread only, may be read by any thread
+  std::atomic<uint64_t> overruns;  // number of cycles which overran their deadline
+  std::atomic<uint64_t> missed;    // number of deadlines which have passed during overruns
+  std::atomic<double> maxLateness; // maximum time in seconds by which a cycle finished after its deadline
 
   std::vector<MonitorFunc> monitors;
 
@@ -46,6 +102,10 @@ class PeriodicCounter {
   int reset_counter;
   time_point start;
   time_point last;
+  Histogram periodHistogram;
+  Histogram jitterHistogram;
+  Histogram runHistogram;
+  std::atomic<uint32_t> sequence;  // odd while the histograms are updated
   logger::Logger log;
 };
 }
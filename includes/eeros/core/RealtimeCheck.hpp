@@ -0,0 +1,145 @@
+#ifndef ORG_EEROS_CORE_REALTIMECHECK_HPP_
+#define ORG_EEROS_CORE_REALTIMECHECK_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eeros {
+
+namespace logger {
+  class Logger;
+}
+
+/**
+ * Kinds of calls and events which must not happen on the realtime path.
+ *
+ * @since v1.3
+ */
+enum class Violation : uint8_t { allocation, deallocation, mutexWait, minorFault, majorFault };
+
+/**
+ * Number of violations of one kind which happened in the same thread and location.
+ *
+ * @since v1.3
+ */
+struct ViolationCount {
+  Violation kind;
+  std::string thread;     // name of the realtime context, e.g. the periodic
+  std::string location;   // block or other location, empty if unknown
+  uint64_t count;
+};
+
+/**
+ * Detects calls on the realtime path which may block or cause page faults, meant for
+ * debugging. The executor marks its cycles and the cycles of the periodics as realtime
+ * contexts, the time domains mark every block they run as a location within such a context.
+ *
+ * While enabled, the minor and major page faults of the calling thread are counted at the
+ * begin and end of every context and location (getrusage()), they are reported for the
+ * location in which they happened. When compiled with EEROS_RT_CHECK (cmake -DUSE_RT_CHECK=TRUE),
+ * malloc(), calloc(), realloc() and free() as well as pthread_mutex_lock() are interposed
+ * and report every allocation, deallocation and every mutex which is already locked by another
+ * thread when a realtime context locks it. This changes these functions for the whole process
+ * and should not be used in production.
+ *
+ * Reporting a violation neither blocks nor allocates memory, the violations are collected
+ * by collect() in a thread without realtime priority. The executor logs them when it stops.
+ *
+ * @since v1.3
+ */
+class RealtimeCheck {
+ public:
+  /**
+   * Enables checking.
+   *
+   * @param abortOnViolation - if true, the first violation is written to stderr and the process is aborted
+   */
+  static void enable(bool abortOnViolation = false);
+
+  static void disable();
+
+  static bool isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Checks whether the calling thread is in a realtime context.
+   *
+   * @return true if in a realtime context and checking is enabled
+   */
+  static bool isRealtime();
+
+  /**
+   * Reports a violation of the calling thread if it is in a realtime context.
+   *
+   * @param kind - kind of the violation
+   * @param count - number of violations
+   */
+  static void report(Violation kind, uint64_t count = 1);
+
+  /**
+   * Collects the violations reported since checking was enabled, summed up by kind,
+   * thread and location. Must not be called in a realtime context.
+   *
+   * @return violations
+   */
+  static std::vector<ViolationCount> collect();
+
+  /**
+   * Gets the number of violations which were lost because they were reported faster
+   * than collected.
+   *
+   * @return number of lost violations
+   */
+  static uint64_t getLost();
+
+  /**
+   * Logs all violations collected so far as warnings.
+   *
+   * @param log - logger
+   */
+  static void log(logger::Logger &log);
+
+  static const char* getName(Violation kind);
+
+  /**
+   * Marks the calling thread as realtime while the context exists. Contexts can be nested.
+   * The names must stay valid while the context exists.
+   */
+  class Context {
+   public:
+    /**
+     * @param thread - name of the context
+     * @param realtime - if false, the context is not marked, e.g. for threads without realtime priority
+     */
+    Context(const char *thread, bool realtime = true);
+    ~Context();
+   private:
+    bool active;
+    bool wasRealtime;
+    const char *previousThread;
+    const char *previousLocation;
+  };
+
+  /**
+   * Marks the location, e.g. a block, in which the calling thread runs while the location exists.
+   */
+  class Location {
+   public:
+    Location(const char *name);
+    ~Location();
+   private:
+    bool active;
+    const char *previous;
+  };
+
+ private:
+  RealtimeCheck();
+  static std::atomic<bool> enabled;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_REALTIMECHECK_HPP_
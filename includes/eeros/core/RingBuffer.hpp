@@ -2,11 +2,252 @@
 #define ORG_EEROS_CORE_SIGNALBUFFER_HPP_
 
 #include <stdint.h>
-#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 
 namespace eeros {
 
+	namespace detail {
+		constexpr std::size_t cacheLineSize = 64;
+
+		constexpr std::size_t nextPowerOfTwo(std::size_t n, std::size_t p = 1) {
+			return (p >= n) ? p : nextPowerOfTwo(n, p << 1);
+		}
+
+		// an atomic index on a cache line of its own
+		struct PaddedIndex {
+			std::atomic<uint64_t> value{0};
+			char pad[cacheLineSize - sizeof(std::atomic<uint64_t>)];
+		};
+
+		// items of a ring buffer with a capacity known at compile time
+		template<typename T, int N>
+		struct RingStorage {
+			static constexpr std::size_t mask = nextPowerOfTwo(N) - 1;
+			std::size_t capacity() const { return N; }
+			T& operator[](std::size_t i) { return items[i & mask]; }
+			T items[mask + 1];
+		};
+
+		// items of a ring buffer with a capacity given on construction
+		template<typename T>
+		struct RingStorage<T, 0> {
+			RingStorage(std::size_t n) : n(n), mask(nextPowerOfTwo(n) - 1), items(new T[mask + 1]) { }
+			std::size_t capacity() const { return n; }
+			T& operator[](std::size_t i) { return items[i & mask]; }
+			std::size_t n;
+			std::size_t mask;
+			std::unique_ptr<T[]> items;
+		};
+	}
+
+	/**
+	 * Wait-free ring buffer for exactly one producer thread and one consumer thread.
+	 * push() and pop() never block and never allocate memory, so the buffer can be used
+	 * to pass items between a realtime and a non-realtime thread.
+	 * The buffer holds up to N items, the storage is rounded up to a power of two so
+	 * that indices are masked instead of taken modulo. With N = 0 the capacity is
+	 * given to the constructor, which allocates the storage once.
+	 *
+	 * @tparam T - item type
+	 * @tparam N - capacity, 0 if given on construction
+	 * @since v1.3
+	 */
+	template<typename T, int N = 32>
+	class SpscRingBuffer {
+		static_assert(N >= 0, "capacity must not be negative");
+	public:
+		SpscRingBuffer() : cachedTail(0), cachedHead(0) { }
+
+		/**
+		 * Constructs a buffer whose capacity is given at run time, N has to be 0.
+		 *
+		 * @param capacity - maximum number of items
+		 */
+		SpscRingBuffer(std::size_t capacity) : cachedTail(0), cachedHead(0), items(capacity) { }
+
+		/**
+		 * Appends an item, called by the producer thread only.
+		 *
+		 * @return false if the buffer is full
+		 */
+		bool push(const T& v) {
+			return push(&v, 1) == 1;
+		}
+
+		/**
+		 * Appends up to n items, called by the producer thread only.
+		 *
+		 * @return number of items appended
+		 */
+		std::size_t push(const T* v, std::size_t n) {
+			uint64_t h = head.value.load(std::memory_order_relaxed);
+			std::size_t capacity = items.capacity();
+			if (h - cachedTail + n > capacity) {
+				cachedTail = tail.value.load(std::memory_order_acquire);
+				if (h - cachedTail + n > capacity) n = capacity - (h - cachedTail);
+			}
+			for (std::size_t i = 0; i < n; i++) items[h + i] = v[i];
+			head.value.store(h + n, std::memory_order_release);
+			return n;
+		}
+
+		/**
+		 * Removes the oldest item, called by the consumer thread only.
+		 *
+		 * @return false if the buffer is empty
+		 */
+		bool pop(T& v) {
+			return pop(&v, 1) == 1;
+		}
+
+		/**
+		 * Removes up to n of the oldest items, called by the consumer thread only.
+		 *
+		 * @return number of items removed
+		 */
+		std::size_t pop(T* v, std::size_t n) {
+			uint64_t t = tail.value.load(std::memory_order_relaxed);
+			if (cachedHead - t < n) {
+				cachedHead = head.value.load(std::memory_order_acquire);
+				if (cachedHead - t < n) n = cachedHead - t;
+			}
+			for (std::size_t i = 0; i < n; i++) v[i] = items[t + i];
+			tail.value.store(t + n, std::memory_order_release);
+			return n;
+		}
+
+		unsigned int length() const {
+			return head.value.load(std::memory_order_acquire) - tail.value.load(std::memory_order_acquire);
+		}
+
+		int size() const { return items.capacity(); }
+
+	private:
+		detail::PaddedIndex head;
+		uint64_t cachedTail;	// producer's copy of tail
+		char pad0[detail::cacheLineSize - sizeof(uint64_t)];
+		detail::PaddedIndex tail;
+		uint64_t cachedHead;	// consumer's copy of head
+		char pad1[detail::cacheLineSize - sizeof(uint64_t)];
+		detail::RingStorage<T, N> items;
+	};
+
+	/**
+	 * Ring buffer for several producer threads and one consumer thread.
+	 * The consumer is wait-free, producers are lock-free: a producer only retries if
+	 * another producer claimed the same slot at the same time. No call ever blocks
+	 * or allocates memory.
+	 * Items pushed in one batch are stored contiguously and in order.
+	 *
+	 * @tparam T - item type
+	 * @tparam N - capacity
+	 * @since v1.3
+	 */
+	template<typename T, int N = 32>
+	class MpscRingBuffer {
+		static_assert(N > 0, "capacity must be positive");
+	public:
+		MpscRingBuffer() {
+			for (auto& s : slots) s.sequence.store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Appends an item, may be called by any thread.
+		 *
+		 * @return false if the buffer is full
+		 */
+		bool push(const T& v) {
+			return push(&v, 1) == 1;
+		}
+
+		/**
+		 * Appends up to n items, may be called by any thread.
+		 *
+		 * @return number of items appended
+		 */
+		std::size_t push(const T* v, std::size_t n) {
+			uint64_t h = head.value.load(std::memory_order_relaxed);
+			std::size_t k;
+			for (;;) {
+				uint64_t t = tail.value.load(std::memory_order_acquire);
+				if (t > h) {	// h is stale, others moved past it in the meantime
+					h = head.value.load(std::memory_order_relaxed);
+					continue;
+				}
+				uint64_t used = h - t;
+				if (used >= N) {
+					uint64_t cur = head.value.load(std::memory_order_relaxed);
+					if (cur == h) return 0;	// full for the current head
+					h = cur;
+					continue;
+				}
+				k = (n < N - used) ? n : N - used;
+				if (k == 0) return 0;
+				if (head.value.compare_exchange_weak(h, h + k, std::memory_order_relaxed)) break;
+			}
+			for (std::size_t i = 0; i < k; i++) {
+				Slot& s = slots[(h + i) & mask];
+				s.item = v[i];
+				s.sequence.store(h + i + 1, std::memory_order_release);
+			}
+			return k;
+		}
+
+		/**
+		 * Removes the oldest item, called by the consumer thread only.
+		 * An item is only returned once the producer has finished writing it.
+		 *
+		 * @return false if the buffer is empty
+		 */
+		bool pop(T& v) {
+			return pop(&v, 1) == 1;
+		}
+
+		/**
+		 * Removes up to n of the oldest items, called by the consumer thread only.
+		 *
+		 * @return number of items removed
+		 */
+		std::size_t pop(T* v, std::size_t n) {
+			uint64_t t = tail.value.load(std::memory_order_relaxed);
+			std::size_t i = 0;
+			for (; i < n; i++) {
+				Slot& s = slots[(t + i) & mask];
+				if (s.sequence.load(std::memory_order_acquire) != t + i + 1) break;
+				v[i] = s.item;
+			}
+			tail.value.store(t + i, std::memory_order_release);
+			return i;
+		}
+
+		unsigned int length() const {
+			return head.value.load(std::memory_order_acquire) - tail.value.load(std::memory_order_acquire);
+		}
+
+		constexpr int size() const { return N; }
+
+	private:
+		struct Slot {
+			std::atomic<uint64_t> sequence;	// position + 1 once the item is written
+			T item;
+		};
+		static constexpr std::size_t mask = detail::nextPowerOfTwo(N) - 1;
+		detail::PaddedIndex head;
+		detail::PaddedIndex tail;
+		Slot slots[mask + 1];
+	};
+
+	/**
+	 * Ring buffer protected by a mutex. Any number of threads may push and pop
+	 * items concurrently. Code which passes items between a realtime and
+	 * a non-realtime thread should choose SpscRingBuffer or MpscRingBuffer.
+	 *
+	 * @tparam T - item type
+	 * @tparam N - capacity
+	 */
 	template<typename T, int N = 32>
 	class RingBuffer {
 	public:
@@ -0,0 +1,70 @@
+#ifndef ORG_EEROS_CORE_SCHEDULABILITY_HPP_
+#define ORG_EEROS_CORE_SCHEDULABILITY_HPP_
+
+#include <string>
+#include <vector>
+
+namespace eeros {
+
+/**
+ * Schedulability analysis of periodic threads with fixed priorities which share one core, 
+ * each of which has to finish a cycle before its next cycle starts. 
+ * The worst-case response time of every thread is calculated from its own run time and the 
+ * run times of all threads with a higher priority (response time analysis). Additionally, 
+ * the total utilization is compared against the bound of Liu and Layland, below which 
+ * rate-monotonic priorities are always schedulable.
+ *
+ * @since v1.3
+ */
+class Schedulability {
+ public:
+  struct Thread {
+    std::string name;
+    double period;        // period and deadline in seconds
+    double runTime;       // worst-case run time of a cycle in seconds
+    int priority;         // threads with a higher value preempt threads with a lower value
+    double responseTime;  // worst-case response time in seconds, calculated by analyse()
+    bool schedulable;     // true if the response time does not exceed the period
+  };
+
+  /**
+   * Adds a thread to the analysis.
+   *
+   * @param name - name used in reports
+   * @param period - period in seconds
+   * @param runTime - worst-case run time in seconds
+   * @param priority - priority, higher values preempt lower values
+   */
+  void add(std::string name, double period, double runTime, int priority);
+
+  /**
+   * Calculates the response time of all threads. Threads with the same priority 
+   * are assumed to delay each other.
+   *
+   * @return true if all threads are schedulable
+   */
+  bool analyse();
+
+  /**
+   * Gets the sum of run time divided by period of all threads.
+   *
+   * @return utilization, 1 corresponds to a fully loaded core
+   */
+  double getUtilization() const;
+
+  /**
+   * Gets the utilization bound of Liu and Layland, n * (2^(1/n) - 1) for n threads.
+   *
+   * @return utilization bound
+   */
+  double getUtilizationBound() const;
+
+  const std::vector<Thread>& getThreads() const;
+
+ private:
+  std::vector<Thread> threads;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_SCHEDULABILITY_HPP_
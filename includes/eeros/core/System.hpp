@@ -11,6 +11,11 @@ namespace eeros {
 	public:
 		static double getClockResolution();
 		static double getTime();
+		
+		/**
+		 * Gets the time of the system in nanoseconds, or the virtual time if 
+		 * VirtualClock is enabled.
+		 */
 		static uint64_t getTimeNs();
 		
 #ifdef USE_ROS
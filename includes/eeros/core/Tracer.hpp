@@ -0,0 +1,137 @@
+#ifndef ORG_EEROS_CORE_TRACER_HPP_
+#define ORG_EEROS_CORE_TRACER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace eeros {
+
+/**
+ * Category of a trace event, each category can be enabled on its own.
+ *
+ * @since v1.3
+ */
+enum class TraceCategory : uint8_t { executor, task, timeDomain, block, safety, sequence, user };
+
+/**
+ * Compact binary trace event, see Tracer.
+ *
+ * @since v1.3
+ */
+struct TraceEvent {
+  enum Phase : uint8_t { begin, end, instant };
+  uint64_t time;      // monotonic clock in nanoseconds
+  uint32_t arg;
+  Phase phase;
+  TraceCategory category;
+  char name[34];      // truncated, always terminated
+};
+
+/**
+ * Records trace events of all threads on a single timeline, e.g. the cycles of the executor
+ * and of the periodics, the blocks run by the time domains, safety events and state changes
+ * of sequences. Every thread writes into a ring buffer of its own, which holds a fixed number
+ * of events and overwrites the oldest events when full. Recording an event neither locks nor
+ * allocates memory, only the first event of a thread which has not registered allocates its buffer.
+ * Realtime threads of the framework register when they start.
+ * When tracing is disabled, recording an event costs a single atomic load.
+ *
+ * The buffers are written in the Chrome trace format, which is shown by chrome://tracing and
+ * by the Perfetto UI, either directly or from a binary file converted by the traceExport tool.
+ *
+ * @since v1.3
+ */
+class Tracer {
+ public:
+  /**
+   * Enables tracing.
+   *
+   * @param capacity - number of events per thread, rounded up to the next power of two
+   * @param categories - bit mask of the enabled categories, bit n enables TraceCategory n
+   */
+  static void enable(std::size_t capacity = 65536, uint32_t categories = ~0u);
+
+  /**
+   * Disables tracing, the recorded events are kept.
+   */
+  static void disable();
+
+  static bool isEnabled(TraceCategory category) {
+    return (categories.load(std::memory_order_relaxed) >> static_cast<unsigned>(category)) & 1;
+  }
+
+  /**
+   * Allocates the buffer of the calling thread if tracing is enabled.
+   *
+   * @param name - name of the thread shown in the trace
+   */
+  static void registerThread(std::string name);
+
+  static void begin(TraceCategory category, const char *name, uint32_t arg = 0) {
+    if (isEnabled(category)) add(TraceEvent::begin, category, name, arg);
+  }
+
+  static void end(TraceCategory category, const char *name, uint32_t arg = 0) {
+    if (isEnabled(category)) add(TraceEvent::end, category, name, arg);
+  }
+
+  static void instant(TraceCategory category, const char *name, uint32_t arg = 0) {
+    if (isEnabled(category)) add(TraceEvent::instant, category, name, arg);
+  }
+
+  /**
+   * Records the begin of a span on construction and its end on destruction.
+   */
+  class Scope {
+   public:
+    Scope(TraceCategory category, const char *name, uint32_t arg = 0) : category(category), name(name), arg(arg) {
+      begin(category, name, arg);
+    }
+    ~Scope() {
+      end(category, name, arg);
+    }
+   private:
+    TraceCategory category;
+    const char *name;
+    uint32_t arg;
+  };
+
+  /**
+   * Discards all recorded events.
+   */
+  static void clear();
+
+  /**
+   * Writes the events of all threads in the Chrome trace format. Events which are
+   * overwritten while writing are left out, as is the oldest event of a full buffer.
+   *
+   * @param os - output stream
+   */
+  static void writeChromeTrace(std::ostream &os);
+
+  /**
+   * Writes the events of all threads into a binary file, see convert().
+   *
+   * @param fileName - name of the file
+   */
+  static void save(std::string fileName);
+
+  /**
+   * Converts a binary file written by save() into the Chrome trace format.
+   *
+   * @param fileName - name of the binary file
+   * @param os - output stream
+   */
+  static void convert(std::string fileName, std::ostream &os);
+
+ private:
+  Tracer();
+  static void add(TraceEvent::Phase phase, TraceCategory category, const char *name, uint32_t arg);
+  static std::atomic<uint32_t> categories;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_TRACER_HPP_
@@ -0,0 +1,88 @@
+#ifndef ORG_EEROS_CORE_VIRTUALCLOCK_HPP_
+#define ORG_EEROS_CORE_VIRTUALCLOCK_HPP_
+
+#include <stdint.h>
+
+namespace eeros {
+
+/**
+ * Simulated time which replaces the clock of the system, see System::getTimeNs(). 
+ * Virtual time stands still until it is advanced, usually by the executor by exactly 
+ * one period per cycle, see Executor::setVirtualTime(). 
+ * 
+ * Threads which wait for a certain time, e.g. sequences polling their exit conditions, 
+ * call sleep(). When virtual time reaches the end of such a sleep, advance() wakes the 
+ * thread and returns only after the thread has gone to sleep again or has finished. 
+ * Thereby, whatever a sequence does at a given time happens before the next cycle. 
+ * A thread which blocks on something else in between has to mark this with a Blocking 
+ * guard, otherwise advance() waits for it until the timeout runs out.
+ *
+ * @since v1.3
+ */
+class VirtualClock {
+ public:
+  /**
+   * Replaces the clock of the system with virtual time.
+   *
+   * @param start - initial virtual time in nanoseconds
+   */
+  static void enable(uint64_t start = 0);
+
+  /**
+   * Returns to the clock of the system and wakes all sleeping threads.
+   */
+  static void disable();
+
+  static bool isEnabled();
+
+  /**
+   * Gets the virtual time.
+   *
+   * @return virtual time in nanoseconds
+   */
+  static uint64_t now();
+
+  /**
+   * Advances virtual time and waits for all threads whose sleep ends until then, 
+   * as long as the timeout allows.
+   *
+   * @param ns - time to advance in nanoseconds
+   */
+  static void advance(uint64_t ns);
+
+  /**
+   * Sleeps for a given time, virtual time if enabled, the time of the system otherwise.
+   *
+   * @param sec - time in seconds
+   */
+  static void sleep(double sec);
+
+  /**
+   * Sets the maximum time in seconds of the system which advance() waits for a woken 
+   * thread to go to sleep again. After this time, the thread is not waited for until 
+   * its next sleep. The default is 1 second.
+   *
+   * @param sec - timeout in seconds
+   */
+  static void setTimeout(double sec);
+
+  /**
+   * Marks a section in which the thread waits for another thread instead of for 
+   * virtual time, e.g. for a sequence to finish. advance() does not wait for the 
+   * thread while it is inside the section.
+   */
+  class Blocking {
+   public:
+    Blocking();
+    ~Blocking();
+   private:
+    bool wasActive;
+  };
+
+ private:
+  VirtualClock();
+};
+
+}
+
+#endif // ORG_EEROS_CORE_VIRTUALCLOCK_HPP_
@@ -0,0 +1,57 @@
+#ifndef ORG_EEROS_CORE_WAKEUP_HPP_
+#define ORG_EEROS_CORE_WAKEUP_HPP_
+
+#include <atomic>
+
+namespace eeros {
+
+/**
+ * Counting wakeup primitive for handing a cycle from one thread to another, based on a 
+ * Linux futex. Unlike Semaphore, post() takes no lock: it increments an atomic counter 
+ * and only enters the kernel if a thread is sleeping in wait(). A realtime thread calling 
+ * post() can therefore never be held up by a lower priority thread holding a mutex, so 
+ * there is no priority inversion which priority inheritance would have to resolve. 
+ * The woken thread runs with its own priority. 
+ * Optionally, wait() spins for a bounded number of iterations before it goes to sleep, 
+ * which saves the wakeup latency of the kernel if the next post() follows shortly. Spinning 
+ * only pays off if the waiting thread has a core of its own.
+ *
+ * @since v1.3
+ */
+class Wakeup {
+ public:
+  /**
+   * Constructs a wakeup primitive.
+   *
+   * @param spinCount - number of iterations wait() spins before it sleeps, 0 to sleep right away
+   */
+  Wakeup(unsigned spinCount = 0);
+
+  /**
+   * Increments the counter and wakes a waiting thread. Never blocks.
+   */
+  void post();
+
+  /**
+   * Waits until the counter is positive and decrements it.
+   */
+  void wait();
+
+  /**
+   * Decrements the counter if it is positive.
+   *
+   * @return true if the counter was decremented
+   */
+  bool tryWait();
+
+  void setSpinCount(unsigned spinCount);
+
+ private:
+  std::atomic<int> count;
+  std::atomic<int> waiters;
+  std::atomic<unsigned> spinCount;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_WAKEUP_HPP_
@@ -1,7 +1,7 @@
 #ifndef ORG_EEROS_HAL_INPUT_HPP_
 #define ORG_EEROS_HAL_INPUT_HPP_
 #include <string>
-#include <eeros/core/System.hpp>
+#include <eeros/core/CycleTime.hpp>
 
 namespace eeros {
 	namespace hal {
@@ -20,7 +20,13 @@ namespace eeros {
 			virtual ~Input() { }
 			virtual inline std::string getId() const { return id; }
 			virtual T get() = 0;
-			virtual uint64_t getTimestamp()	{ return System::getTimeNs(); }
+			
+			/**
+			 * Gets the timestamp of the value returned by get(), the time of the current cycle 
+			 * by default, see CycleTime. Inputs which know when their values were sampled, 
+			 * e.g. by the hardware, return that time instead.
+			 */
+			virtual uint64_t getTimestamp()	{ return CycleTime::now(); }
 			virtual void *getLibHandle() { return libHandle; }
 		private:
 			std::string id;
@@ -2,7 +2,9 @@
 #define ORG_EEROS_LOGGER_LOGENTRY_HPP_
 
 #include <eeros/logger/LogWriter.hpp>
+#include <chrono>
 #include <memory>
+#include <new>
 #include <iostream>
 
 namespace eeros {
@@ -25,10 +27,23 @@ public:
    * @param level - LogLevel
    * @param category - category
    */
-  LogEntry(std::shared_ptr<LogWriter> writer, LogLevel level, unsigned category = 0) 
-      : w(std::move(writer)) {
-    enable = (level <= w->visible_level);
-    if(enable) w->begin(os, level, category);
+  LogEntry(const std::shared_ptr<LogWriter>& writer, LogLevel level, unsigned category = 0) 
+      : enable(writer && level <= writer->visible_level), rt(false) {  // no writer set, nothing gets logged
+    if (!enable) return;  // a suppressed entry neither holds the writer nor creates a stream
+    w = writer;
+    rt = w->realtime();
+    if (rt) {
+      // write into a fixed size record instead of a string, the writer formats 
+      // the record and the raw values of numbers later in its own thread
+      record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count();
+      record.level = level;
+      record.category = category;
+      new (&rs) LogRecordStream(record);
+    } else {
+      new (&os) std::ostringstream();
+      w->begin(os, level, category);
+    }
   }
   
   /** 
@@ -40,7 +55,15 @@ public:
    * Ends inserting into \ref LogWriter.
    */
   virtual ~LogEntry() {
-    if(enable) w->end(os);
+    if (!enable) return;
+    if (rt) {
+      record.length = rs.length();
+      w->commit(record);
+      rs.~LogRecordStream();
+    } else {
+      w->end(os);
+      os.std::ostringstream::~ostringstream();
+    }
   }
 
   /**
@@ -52,7 +75,8 @@ public:
    */
   template <typename T>
   LogEntry& operator<<(const T& value) {
-    os << value;
+    if (rt) rs.append(value);
+    else if (enable) os << value;
     return *this;
   }
   
@@ -65,7 +89,8 @@ public:
    */
   template <typename T> 
   LogEntry& operator<<(T&& value) {
-    os << std::forward<T>(value);
+    if (rt) rs.append(std::forward<T>(value));
+    else if (enable) os << std::forward<T>(value);
     return *this;
   }
   
@@ -76,14 +101,20 @@ public:
    * @return LogEntry
    */
   LogEntry& operator<<(void (*f)(LogWriter&) ) {
-    w->endl(os);
+    if (rt) rs.append('\n');
+    else if (enable) w->endl(os);
     return *this;
   }
   
  private:
-  std::shared_ptr<LogWriter> w;
-  std::ostringstream os;
   bool enable;  // every LogEntry must decide itself, if it gets logged
+  bool rt;      // realtime writer, entry is written into record
+  std::shared_ptr<LogWriter> w;
+  union {       // only constructed if enabled
+    std::ostringstream os;
+    LogRecordStream rs;
+  };
+  LogRecord record;
 };
 
 }
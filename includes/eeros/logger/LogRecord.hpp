@@ -0,0 +1,204 @@
+#ifndef ORG_EEROS_LOGGER_LOGRECORD_HPP_
+#define ORG_EEROS_LOGGER_LOGRECORD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+namespace eeros {
+namespace logger {
+
+enum class LogLevel;
+
+/**
+ * A log message of fixed size as it is passed to a realtime \ref LogWriter.
+ * It holds the message text and the raw values of numbers and booleans,
+ * see \ref LogRecordStream. Timestamp, level and values are formatted later
+ * by the writer. Longer messages are truncated.
+ *
+ * @since v1.3
+ */
+
+struct LogRecord {
+  static constexpr std::size_t textSize = 232;
+  int64_t time;         // nanoseconds since the epoch
+  LogLevel level;
+  unsigned category;
+  uint32_t length;
+  char text[textSize];
+
+  /**
+   * Formats the text and the raw values of this record.
+   *
+   * @param os - stream to write to
+   */
+  void format(std::ostream& os) const;
+};
+
+/**
+ * Stream buffer which writes into the text of a \ref LogRecord without allocating memory.
+ * Bytes below 8 mark raw values in the text, such bytes of the text itself are escaped.
+ *
+ * @since v1.3
+ */
+
+class LogRecordBuffer : public std::streambuf {
+ public:
+  static constexpr char escape = 0;
+  static constexpr char endOfMarkers = 8;  // markers of raw values are 1 .. 7, see LogRecordStream
+
+  void reset(LogRecord& record) {
+    begin = pos = record.text;
+    end = record.text + LogRecord::textSize;
+  }
+
+  uint32_t length() const {
+    return static_cast<uint32_t>(pos - begin);
+  }
+
+  /**
+   * Writes a marker followed by the bytes of a raw value, either all of them or
+   * nothing if they do not fit anymore.
+   */
+  void raw(char marker, const void* value, std::size_t size) {
+    if (static_cast<std::size_t>(end - pos) < size + 1) {
+      end = pos;  // truncated, text which would still fit is dropped as well
+      return;
+    }
+    *pos++ = marker;
+    std::memcpy(pos, value, size);
+    pos += size;
+  }
+
+ protected:
+  virtual int_type overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    char ch = traits_type::to_char_type(c);
+    if (static_cast<unsigned char>(ch) < endOfMarkers) {
+      if (end - pos < 2) {
+        end = pos;
+        return c;
+      }
+      *pos++ = escape;
+    }
+    else if (pos == end) return c;
+    *pos++ = ch;
+    return c;
+  }
+
+  virtual std::streamsize xsputn(const char* s, std::streamsize n) {
+    for (std::streamsize i = 0; i < n; i++) {
+      if (static_cast<unsigned char>(s[i]) >= endOfMarkers && pos < end) *pos++ = s[i];
+      else overflow(traits_type::to_int_type(s[i]));
+    }
+    return n;
+  }
+
+ private:
+  char* begin = nullptr;
+  char* pos = nullptr;
+  char* end = nullptr;
+};
+
+/**
+ * Output stream which writes into the text of a \ref LogRecord without allocating memory.
+ * Integers, floating point numbers and booleans are not formatted but stored raw, together
+ * with the flags, precision, width and fill character of the stream, and are formatted by
+ * the writer, see LogRecord::format(). Everything else is formatted immediately.
+ *
+ * @since v1.3
+ */
+
+class LogRecordStream : public std::ostream {
+ public:
+  LogRecordStream(LogRecord& record) : std::ostream(nullptr),
+      lastFlags(flags()), lastPrecision(precision()), lastWidth(width()), lastFill(fill()) {
+    buf.reset(record);
+    rdbuf(&buf);
+  }
+
+  uint32_t length() const {
+    return buf.length();
+  }
+
+  /**
+   * Appends a value, formatted immediately.
+   *
+   * @param value - value
+   */
+  template < typename T >
+  void append(T&& value) {
+    *this << std::forward<T>(value);
+  }
+
+  void append(bool value) { raw(boolMarker, value); }
+  void append(int value) { raw(int32Marker, static_cast<int32_t>(value)); }
+  void append(long value) { raw(int64Marker, static_cast<int64_t>(value)); }
+  void append(long long value) { raw(int64Marker, static_cast<int64_t>(value)); }
+  void append(unsigned value) { raw(uint32Marker, static_cast<uint32_t>(value)); }
+  void append(unsigned long value) { raw(uint64Marker, static_cast<uint64_t>(value)); }
+  void append(unsigned long long value) { raw(uint64Marker, static_cast<uint64_t>(value)); }
+  void append(float value) { raw(doubleMarker, static_cast<double>(value)); }
+  void append(double value) { raw(doubleMarker, value); }
+
+  void append(char value) {
+    if (width() == 0) buf.sputc(value);
+    else *this << value;
+  }
+
+  void append(const char* value) {
+    if (width() == 0) buf.sputn(value, std::strlen(value));
+    else *this << value;
+  }
+
+  void append(const std::string& value) {
+    if (width() == 0) buf.sputn(value.data(), value.size());
+    else *this << value;
+  }
+
+  static constexpr char formatMarker = 1;
+  static constexpr char boolMarker = 2;
+  static constexpr char int32Marker = 3;
+  static constexpr char int64Marker = 4;
+  static constexpr char uint32Marker = 5;
+  static constexpr char uint64Marker = 6;
+  static constexpr char doubleMarker = 7;
+
+  // flags, precision, width and fill character as stored after the format marker
+  struct Format {
+    uint32_t flags;
+    int32_t precision;
+    int32_t width;
+    char fill;
+  } __attribute__((packed));
+
+ private:
+  template < typename T >
+  void raw(char marker, T value) {
+    if (flags() != lastFlags || precision() != lastPrecision || width() != lastWidth || fill() != lastFill) {
+      lastFlags = flags();
+      lastPrecision = precision();
+      lastWidth = width();
+      lastFill = fill();
+      Format f{static_cast<uint32_t>(lastFlags), static_cast<int32_t>(lastPrecision), static_cast<int32_t>(lastWidth), lastFill};
+      buf.raw(formatMarker, &f, sizeof(f));
+    }
+    buf.raw(marker, &value, sizeof(value));
+    width(0);  // as formatting the value would do
+  }
+
+  LogRecordBuffer buf;
+  fmtflags lastFlags;
+  std::streamsize lastPrecision;
+  std::streamsize lastWidth;
+  char lastFill;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_LOGRECORD_HPP_ */
@@ -2,6 +2,8 @@
 #define ORG_EEROS_LOGGER_LOGWRITER_HPP_
 
 #include <eeros/logger/Writer.hpp>
+#include <eeros/logger/LogRecord.hpp>
+#include <cstdint>
 
 namespace eeros {
 namespace logger {
@@ -23,6 +25,14 @@ class LogWriter : public Writer {
   virtual void begin(std::ostringstream& os, LogLevel level, unsigned category) = 0;	
   virtual void end(std::ostringstream& os) = 0;
   virtual void endl(std::ostringstream& os) = 0;
+  
+  /**
+   * A realtime writer returns true. Its log entries are written into a \ref LogRecord
+   * which is passed to commit() instead of calling begin() and end().
+   */
+  virtual bool realtime() const { return false; }
+  virtual void commit(const LogRecord& record) { }
+  virtual uint64_t dropped() const { return 0; }
   LogLevel visible_level;
 };
 
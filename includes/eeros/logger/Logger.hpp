@@ -4,6 +4,7 @@
 #include <eeros/logger/LogEntry.hpp>
 #include <eeros/logger/LogWriter.hpp>
 #include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/logger/RealtimeLogWriter.hpp>
 #include <sstream>
 #include <string>
 #include <memory>
@@ -103,6 +104,56 @@ class Logger {
     log = makeLogger<StreamLogWriter>(os, logFile);
   }
   
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to a \ref RealtimeLogWriter.
+   * Logging does neither block nor allocate memory, the messages are written to 
+   * a std::ostream by a background thread.
+   * 
+   * @param os - output stream to which the RealtimeLogWriter will write
+   * @since v1.3
+   */
+  static void setDefaultRealtimeLogger(std::ostream& os) {
+    log = makeLogger<RealtimeLogWriter>(os);
+  }
+  
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to a \ref RealtimeLogWriter.
+   * Logging does neither block nor allocate memory, the messages are written to 
+   * a std::ostream and into a log file by a background thread.
+   * 
+   * @param os - output stream to which the RealtimeLogWriter will write
+   * @param logFile - log file name
+   * @since v1.3
+   */
+  static void setDefaultRealtimeLogger(std::ostream& os, std::string logFile) {
+    log = makeLogger<RealtimeLogWriter>(os, logFile);
+  }
+  
+  /**
+   * Returns the number of log messages which were dropped by the \ref LogWriter
+   * of this logger, only a \ref RealtimeLogWriter drops messages.
+   * 
+   * @return number of dropped messages
+   * @since v1.3
+   */
+  uint64_t getDropped() const {
+    return w ? w->dropped() : 0;
+  }
+  
+  /**
+   * Checks if a message with a given level would be logged. This check is cheap,
+   * no \ref LogEntry is created.
+   * 
+   * @param level - log level
+   * @return true if messages with this level are logged
+   * @since v1.3
+   */
+  bool isEnabled(LogLevel level) const {
+    return w && level <= w->visible_level;
+  }
+  
   /**
    * Sets the visible level of this logger to a chosen level.
    * All messages with a level below this chosen level are suppressed.
@@ -128,4 +179,24 @@ class Logger {
 }
 }
 
+/**
+ * Log statements which are removed at compile time if their level is above 
+ * EEROS_LOG_LEVEL (0 = FATAL .. 4 = TRACE, default 4) and whose arguments are only
+ * evaluated if the level is visible at run time.
+ * Usage: EEROS_LOG_TRACE(log) << "value = " << value;
+ */
+#ifndef EEROS_LOG_LEVEL
+#define EEROS_LOG_LEVEL 4
+#endif
+
+#define EEROS_LOG(log, level, entry) \
+  if (static_cast<int>(eeros::logger::LogLevel::level) > EEROS_LOG_LEVEL || !(log).isEnabled(eeros::logger::LogLevel::level)) ; \
+  else (log).entry()
+
+#define EEROS_LOG_FATAL(log) EEROS_LOG(log, FATAL, fatal)
+#define EEROS_LOG_ERROR(log) EEROS_LOG(log, ERROR, error)
+#define EEROS_LOG_WARN(log) EEROS_LOG(log, WARN, warn)
+#define EEROS_LOG_INFO(log) EEROS_LOG(log, INFO, info)
+#define EEROS_LOG_TRACE(log) EEROS_LOG(log, TRACE, trace)
+
 #endif /* ORG_EEROS_LOGGER_LOGGER_HPP_ */
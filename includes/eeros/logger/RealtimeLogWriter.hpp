@@ -0,0 +1,76 @@
+#ifndef ORG_EEROS_LOGGER_REALTIMELOGWRITER_HPP_
+#define ORG_EEROS_LOGGER_REALTIMELOGWRITER_HPP_
+
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/core/RingBuffer.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace eeros {
+namespace logger {
+
+/**
+ * A RealtimeLogWriter can be used from realtime threads. Log entries are written
+ * into preallocated records of fixed size and are queued lock-free, no memory is allocated
+ * and no system call is made by the logging thread. A background thread formats 
+ * timestamp, category and level of the queued records and writes them to a std::ostream
+ * and optionally into a log file, with the same format as the \ref StreamLogWriter.
+ * If the queue is full, log messages are dropped and counted.
+ * 
+ * @since v1.3
+ */
+
+class RealtimeLogWriter : public StreamLogWriter {
+ public:
+  static constexpr int queueSize = 1024;
+  
+  /**
+   * Creates a RealtimeLogWriter sending its messages to a std::ostream such as std::cout.
+   * 
+   * @param out - std::ostream
+   * @param interval - period with which the background thread checks for new messages
+   */
+  RealtimeLogWriter(std::ostream& out, std::chrono::milliseconds interval = std::chrono::milliseconds(10));
+  
+  /**
+   * Creates a RealtimeLogWriter sending its messages to a std::ostream such as std::cout
+   * and a log file. The file name is appended with the current time and date.
+   * 
+   * @param out - std::ostream
+   * @param logFile - log file name
+   * @param interval - period with which the background thread checks for new messages
+   */
+  RealtimeLogWriter(std::ostream& out, std::string logFile, std::chrono::milliseconds interval = std::chrono::milliseconds(10));
+  
+  /** 
+   * Destructor, writes all queued messages and stops the background thread.
+   */
+  ~RealtimeLogWriter();
+  
+  /**
+   * Returns the number of log messages which were dropped because the queue was full.
+   * 
+   * @return number of dropped messages
+   */
+  virtual uint64_t dropped() const;
+
+ private:
+  virtual bool realtime() const;
+  virtual void commit(const LogRecord& record);
+  void run();
+  bool flush();
+  void write(const LogRecord& record);
+  
+  MpscRingBuffer<LogRecord, queueSize> queue;
+  std::atomic<uint64_t> nofDropped;
+  uint64_t reportedDropped;
+  std::chrono::milliseconds interval;
+  std::atomic<bool> finished;
+  std::thread thread;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_REALTIMELOGWRITER_HPP_ */
@@ -2,6 +2,7 @@
 #define ORG_EEROS_LOGGER_STREAMLOGWRITER_HPP_
 
 #include <eeros/logger/LogWriter.hpp>
+#include <chrono>
 #include <fstream>
 
 namespace eeros {
@@ -37,15 +38,25 @@ class StreamLogWriter : public LogWriter {
    */
   ~StreamLogWriter();
 
- private:  
+ protected:
+  /**
+   * Writes time, category and level of a log message.
+   * 
+   * @param os - stream to write to
+   * @param time - time of the log message
+   * @param level - LogLevel
+   * @param category - category
+   */
+  void header(std::ostream& os, std::chrono::system_clock::time_point time, LogLevel level, unsigned category);
+  
+  std::ostream& out;
+  std::ofstream fileOut;
+  bool colored;
+
   virtual void show(LogLevel level = LogLevel::TRACE);	
   virtual void begin(std::ostringstream& os, LogLevel level, unsigned category);
   virtual void end(std::ostringstream& os);
   virtual void endl(std::ostringstream& os);
-
-  std::ostream& out;
-  std::ofstream fileOut;
-  bool colored;
 };
     
 }
@@ -2,6 +2,7 @@
 #define ORG_EEROS_SEQUENCER_WAIT_HPP_
 
 #include <eeros/sequencer/Step.hpp>
+#include <eeros/core/System.hpp>
 
 namespace eeros {
 namespace sequencer {
@@ -35,10 +36,10 @@ public:
   int operator() (double waitingTime) {this->waitingTime = waitingTime; return start();}
  
  private:
-  int action() {time = std::chrono::steady_clock::now(); return 0;}
-  bool checkExitCondition() {return ((std::chrono::duration<double>)(std::chrono::steady_clock::now() - time)).count() > waitingTime;}
+  int action() {time = System::getTimeNs(); return 0;}
+  bool checkExitCondition() {return (System::getTimeNs() - time) * 1e-9 > waitingTime;}
   
-  std::chrono::time_point<std::chrono::steady_clock> time;
+  uint64_t time;  // in ns, follows virtual time if enabled
   double waitingTime;
 };
 
@@ -1,36 +1,141 @@
 #ifndef ORG_EEROS_TASK_ASYNC_HPP_
 #define ORG_EEROS_TASK_ASYNC_HPP_
 
-#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <pthread.h>
 
 #include <eeros/core/Runnable.hpp>
+#include <eeros/core/OverrunPolicy.hpp>
 #include <eeros/core/Semaphore.hpp>
+#include <eeros/core/Wakeup.hpp>
 #include <eeros/core/PeriodicCounter.hpp>
 #include <eeros/logger/Logger.hpp>
 
 namespace eeros {
+
+namespace safety {
+  class SafetySystem;
+  class SafetyEvent;
+}
+
 namespace task {
 
+/**
+ * Runs a task in a thread of its own. Every call of run() makes the thread run the task once.
+ * With a period, the thread runs the task periodically on absolute deadlines of its own timer 
+ * instead, the first call of run() starts the timer and further calls have no effect. 
+ * 
+ * The deadline of a cycle is the start of the next cycle. If run() is called while the thread 
+ * has not yet finished or not even started the previous cycle, the deadline is missed. 
+ * Deadline misses are handled according to the overrun policy and counted as overruns in the 
+ * counter, together with the maximum lateness.
+ * The name identifies the thread in traces, see Tracer.
+ * The stack of the thread is prefaulted completely when the thread starts.
+ */
 class Async : public Runnable {
  public:
-  Async(Runnable &task, bool realtime = false, int nice = 0);
-  Async(Runnable *task, bool realtime = false, int nice = 0);
+  Async(Runnable &task, bool realtime = false, int nice = 0, std::vector<int> cpus = {}, double period = 0, std::string name = "async", std::size_t stackSize = 0);
+  Async(Runnable *task, bool realtime = false, int nice = 0, std::vector<int> cpus = {}, double period = 0, std::string name = "async", std::size_t stackSize = 0);
   virtual ~Async();
   virtual void run();
   void stop();
   void join();
 
+  /**
+   * Waits until the thread is ready to run. A thread is ready as soon as its stack 
+   * is prefaulted and, in case of a realtime thread, its priority is set and memory is locked.
+   *
+   * @param timeout_sec - maximum time to wait in seconds
+   * @return true, if the thread is ready, false on timeout
+   */
+  bool waitReady(double timeout_sec);
+
+  /**
+   * Sets the policy in case a cycle misses its deadline. Without a period, catchUp runs 
+   * every missed cycle later on, skip drops the cycles which are released while the thread 
+   * is busy, coalesce runs them as one cycle as soon as the thread has finished and 
+   * triggerEvent triggers a safety event and drops them. The default policy is catchUp.
+   * 
+   * @param policy - overrun policy
+   * @since v1.3
+   */
+  void setOverrunPolicy(OverrunPolicy policy);
+
+  /**
+   * Sets the overrun policy to triggerEvent.
+   * 
+   * @param ss - safety system
+   * @param e - safety event which is triggered upon a deadline miss
+   * @since v1.3
+   */
+  void setOverrunPolicy(safety::SafetySystem &ss, safety::SafetyEvent &e);
+
+  /**
+   * Sets the number of iterations the thread spins before it goes to sleep while waiting 
+   * for the next cycle, see Wakeup. Spinning lowers the wakeup latency but keeps the core busy.
+   * 
+   * @param spinCount - number of iterations, 0 to sleep right away
+   * @since v1.3
+   */
+  void setSpinCount(unsigned spinCount);
+
+  /**
+   * Checks whether the thread has finished all released cycles.
+   * 
+   * @return true if no cycle is running or pending
+   * @since v1.3
+   */
+  bool isIdle() const;
+
+  /**
+   * Gets the size of the stack of the thread, valid after join().
+   * 
+   * @return number of bytes
+   * @since v1.3
+   */
+  std::size_t getStackSize() const;
+
+  /**
+   * Gets the maximum stack usage of the thread, valid after join(), 
+   * see Executor::get_stack_high_water().
+   * 
+   * @return number of bytes
+   * @since v1.3
+   */
+  std::size_t getStackHighWater() const;
+
   PeriodicCounter counter;
 
  private:
+  void create();
+  static void* start(void *async);
   void run_thread();
+  void run_timed();
+  void release();
   Runnable &task;
+  std::string name;
   bool realtime;
   int nice;
-  Semaphore semaphore;
-  std::thread thread;
+  std::vector<int> cpus;
+  double period;
+  OverrunPolicy overrunPolicy;
+  safety::SafetySystem *safetySystem;
+  safety::SafetyEvent *overrunEvent;
+  std::atomic<bool> busy;          // the thread is running a cycle
+  std::atomic<bool> started;       // the timer of a periodic thread has been started
+  std::atomic<int> pending;        // released cycles which have not been started yet
+  std::atomic<uint64_t> misses;    // deadline misses since the last cycle finished
+  std::atomic<uint64_t> missTime;  // time of the first of these misses in nanoseconds
+  Wakeup wakeup;
+  Semaphore readySemaphore;
   bool finished;
+  std::size_t stackSize;
+  std::size_t stackHighWater;
   logger::Logger log;
+  pthread_t thread;
+  bool joinable;
 };
 
 }
@@ -6,14 +6,30 @@
 namespace eeros {
 	namespace task {
 
+		/**
+		 * Runs a task on every n-th call of run(). With phase p, the task runs on the 
+		 * calls with index n - 1 + p modulo n (counted from 0), so tasks with the same n 
+		 * but different phases never run on the same call.
+		 */
 		class Harmonic : public Runnable {
 		public:
-			Harmonic(Runnable &task, int n = 1);
-			Harmonic(Runnable *task, int n = 1);
+			Harmonic(Runnable &task, int n = 1, int phase = 0);
+			Harmonic(Runnable *task, int n = 1, int phase = 0);
 			Runnable *getTask();
+			int getN() const;
+			int getPhase() const;
+
+			/**
+			 * Shifts the task to another phase. Called while running, the task 
+			 * runs once earlier or later and keeps its period afterwards.
+			 * 
+			 * @param phase - phase in calls of run(), taken modulo n
+			 * @since v1.3
+			 */
+			void setPhase(int phase);
 			virtual void run();
 		private:
-			int n, k;
+			int n, k, phase;
 			Runnable *task;
 		};
 
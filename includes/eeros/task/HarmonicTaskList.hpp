@@ -1,6 +1,7 @@
 #ifndef ORG_EEROS_TASK_HARMONICTASKLIST_HPP_
 #define ORG_EEROS_TASK_HARMONICTASKLIST_HPP_
 
+#include <cstddef>
 #include <vector>
 #include <eeros/core/Runnable.hpp>
 #include <eeros/task/Harmonic.hpp>
@@ -11,9 +12,50 @@ namespace eeros {
 		class HarmonicTaskList : public Runnable {
 		public:
 			virtual void run();
-			virtual void add(Runnable *t, int n = 1);
-			virtual void add(Runnable &t, int n = 1);
+			virtual void add(Runnable *t, int n = 1, int phase = 0);
+			virtual void add(Runnable &t, int n = 1, int phase = 0);
+
+			/**
+			 * Assigns a phase to every task so that the tasks do not pile up on the same call of run().
+			 * The tasks are placed one after the other, the one with the longest run time first, each 
+			 * onto the phase which results in the lowest peak load of any call over a hyperperiod.
+			 * Does not allocate memory if called again with the same number of tasks. 
+			 * Throws std::invalid_argument if not every task has a run time.
+			 * 
+			 * @param runTimes - run time of every task, in the order of tasks
+			 * @param fixed - flags of the tasks whose phase must not be changed, empty if none
+			 * @since v1.3
+			 */
+			void stagger(const std::vector<double> &runTimes, const std::vector<bool> &fixed = {});
+
+			/**
+			 * Gets the highest sum of the run times of the tasks run by one call of run() 
+			 * with the current phases, over a hyperperiod. 
+			 * Throws std::invalid_argument if not every task has a run time.
+			 * 
+			 * @param runTimes - run time of every task, in the order of tasks
+			 * @return peak load per call, in the unit of the run times
+			 * @since v1.3
+			 */
+			double getPeakLoad(const std::vector<double> &runTimes);
+
+			/**
+			 * Gets the number of calls of run() after which the pattern of tasks repeats, 
+			 * that is the least common multiple of all n, limited to maxHyperperiod.
+			 * 
+			 * @return hyperperiod in calls of run()
+			 * @since v1.3
+			 */
+			std::size_t getHyperperiod() const;
+
+			static constexpr std::size_t maxHyperperiod = 1 << 20;
+
 			std::vector<Harmonic> tasks;
+
+		private:
+			void addLoad(std::size_t i, double runTime);
+			std::vector<double> load;
+			std::vector<std::size_t> order;
 		};
 
 	}
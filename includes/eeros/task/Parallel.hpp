@@ -0,0 +1,89 @@
+#ifndef ORG_EEROS_TASK_PARALLEL_HPP_
+#define ORG_EEROS_TASK_PARALLEL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sched.h>
+
+#include <eeros/core/Runnable.hpp>
+#include <eeros/task/TaskList.hpp>
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+namespace task {
+
+/**
+ * Runs several independent task lists in parallel. The first task list is run by the
+ * thread calling run(), every other task list is run by its own worker thread.
+ * run() returns as soon as all task lists have finished.
+ * The worker threads adopt the scheduling policy and priority of the thread calling run()
+ * and can be pinned to chosen cores. While waiting for the next cycle, a worker spins for
+ * a given number of iterations before it goes to sleep.
+ * If a task list throws an exception, the exception is rethrown by run().
+ *
+ * The task lists must not share any data, otherwise the result is not deterministic.
+ *
+ * @since v1.3
+ */
+class Parallel : public Runnable {
+ public:
+  /**
+   * Constructs a parallel runnable and starts a worker thread for every but the first task list.
+   *
+   * @param partitions - task lists to be run in parallel
+   * @param cpus - core of each worker thread, worker i is pinned to cpus[i], -1 or missing means no pinning
+   * @param spinCount - number of iterations a worker spins before it sleeps
+   */
+  Parallel(std::vector<TaskList> partitions, std::vector<int> cpus = {}, unsigned spinCount = 10000);
+
+  /**
+   * Destructor, stops and joins all worker threads.
+   */
+  virtual ~Parallel();
+
+  /**
+   * Runs all task lists and returns after all of them have finished.
+   */
+  virtual void run();
+
+  /**
+   * Gets the number of task lists which are run in parallel.
+   *
+   * @return number of partitions
+   */
+  std::size_t getNofPartitions() const;
+
+ private:
+  struct Worker {
+    TaskList tasks;
+    int cpu;
+    std::exception_ptr error;
+    std::thread thread;
+  };
+  void run_worker(Worker& worker);
+
+  TaskList first;
+  std::vector<std::unique_ptr<Worker>> workers;
+  unsigned spinCount;
+  std::atomic<uint64_t> generation;
+  std::atomic<std::size_t> pending;
+  std::atomic<int> sleepers;
+  std::atomic<bool> finished;
+  uint64_t cycleTime;  // of the thread calling run(), published to the workers with the generation
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool schedulingSet;
+  int policy;
+  struct sched_param schedulingParam;
+  logger::Logger log;
+};
+
+}
+}
+
+#endif // ORG_EEROS_TASK_PARALLEL_HPP_
@@ -6,13 +6,22 @@
 
 #include <eeros/core/Runnable.hpp>
 #include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/core/OverrunPolicy.hpp>
 
 namespace eeros {
+
+namespace safety {
+  class SafetySystem;
+  class SafetyEvent;
+}
+
 namespace task {
 
 /**
  * A periodic is used to be run by the @ref Executor. 
  * All periodics must be harmonic. That is, their periods must be a integral multiple the base periodic.
+ * In the scheduling mode SchedulingMode::rateMonotonic of the executor, periodics which are not harmonic 
+ * run on a timer of their own.
  *  
  * @since v0.4
  */
@@ -109,6 +118,136 @@ class Periodic {
     nice = value;
   }
 
+  /**
+   * Sets the cores on which the thread of this periodic may run. The executor 
+   * checks the cores against the available and isolated cores at startup.
+   * 
+   * @param cpus - cores, an empty vector allows all cores
+   */
+  void setCpus(std::vector<int> cpus) {
+    this->cpus = cpus;
+  }
+
+  /**
+   * Gets the cores on which the thread of this periodic may run.
+   * 
+   * @return cores, empty if not pinned
+   */
+  std::vector<int> getCpus() {
+    return cpus;
+  }
+
+  /**
+   * Sets the phase of the periodic, that is the number of base periods by which its 
+   * cycles are shifted against the cycles of the other periodics with the same base. 
+   * Periodics with a negative phase get a phase assigned by the executor if staggering 
+   * is enabled, see Executor::setStaggering(), and phase 0 otherwise.
+   * 
+   * @param phase - phase in base periods, -1 for automatic
+   * @since v1.3
+   */
+  void setPhase(int phase) {
+    this->phase = phase;
+  }
+
+  /**
+   * Gets the phase of the periodic.
+   * 
+   * @return phase in base periods, -1 for automatic
+   * @since v1.3
+   */
+  int getPhase() {
+    return phase;
+  }
+
+  /**
+   * Sets the expected run time of the periodic, used by the executor to assign phases, 
+   * to estimate the utilization and to analyse the schedulability before the run time 
+   * has been measured.
+   * 
+   * @param runTime - run time in seconds, 0 if unknown
+   * @since v1.3
+   */
+  void setRunTime(double runTime) {
+    this->runTime = runTime;
+  }
+
+  /**
+   * Gets the expected run time of the periodic.
+   * 
+   * @return run time in seconds, 0 if unknown
+   * @since v1.3
+   */
+  double getRunTime() {
+    return runTime;
+  }
+
+  /**
+   * Sets the policy of the thread of this periodic in case a cycle misses its deadline, 
+   * see Async::setOverrunPolicy(). The default policy is catchUp.
+   * 
+   * @param policy - overrun policy, triggerEvent requires a safety event
+   * @since v1.3
+   */
+  void setOverrunPolicy(OverrunPolicy policy) {
+    overrunPolicy = policy;
+  }
+
+  /**
+   * Sets the overrun policy to triggerEvent.
+   * 
+   * @param ss - safety system
+   * @param e - safety event which is triggered upon a deadline miss
+   * @since v1.3
+   */
+  void setOverrunPolicy(safety::SafetySystem &ss, safety::SafetyEvent &e) {
+    overrunPolicy = OverrunPolicy::triggerEvent;
+    safetySystem = &ss;
+    overrunEvent = &e;
+  }
+
+  OverrunPolicy getOverrunPolicy() {
+    return overrunPolicy;
+  }
+
+  safety::SafetySystem* getSafetySystem() {
+    return safetySystem;
+  }
+
+  safety::SafetyEvent* getOverrunEvent() {
+    return overrunEvent;
+  }
+
+  /**
+   * Sets the number of iterations the thread of this periodic spins before it goes to sleep 
+   * while waiting for its next cycle, see Async::setSpinCount().
+   * 
+   * @param spinCount - number of iterations, 0 to sleep right away
+   * @since v1.3
+   */
+  void setSpinCount(unsigned spinCount) {
+    this->spinCount = spinCount;
+  }
+
+  unsigned getSpinCount() {
+    return spinCount;
+  }
+
+  /**
+   * Sets the size of the stack of the thread of this periodic. The whole stack is prefaulted 
+   * when the thread starts and its high-water mark is logged when the executor stops.
+   * 
+   * @param size - number of bytes, 0 for the default size of threads (ulimit -s)
+   * @since v1.3
+   */
+  void setStackSize(std::size_t size) {
+    stackSize = size;
+  }
+
+  std::size_t getStackSize() {
+    return stackSize;
+  }
+
   /**
    * A periodic can be chosen to be run before another periodic.
    * In such a case you have to add it to this vector.
@@ -133,6 +272,14 @@ class Periodic {
   Runnable *task;
   bool realtime;
   int nice;
+  std::vector<int> cpus;
+  int phase = -1;
+  double runTime = 0;
+  OverrunPolicy overrunPolicy = OverrunPolicy::catchUp;
+  safety::SafetySystem *safetySystem = nullptr;
+  safety::SafetyEvent *overrunEvent = nullptr;
+  unsigned spinCount = 0;
+  std::size_t stackSize = 0;
 };
 
 }
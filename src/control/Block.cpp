@@ -1,11 +1,24 @@
-#include <eeros/control/Block.hpp>
-
-using namespace eeros::control;
-
-void Block::setName(std::string name) {
-	this->name = name;
-}
-
-std::string Block::getName() const {
-	return name;
-}
\ No newline at end of file
+#include <eeros/control/Block.hpp>
+
+using namespace eeros::control;
+
+void Block::setName(std::string name) {
+	this->name = name;
+}
+
+std::string Block::getName() const {
+	return name;
+}
+
+void Block::registerInput(InputInterface* input) {
+	for (auto i : inputs) if (i == input) return;
+	inputs.push_back(input);
+}
+
+const std::vector<InputInterface*>& Block::getInputs() const {
+	return inputs;
+}
+
+bool Block::hasDirectFeedthrough() const {
+	return true;
+}
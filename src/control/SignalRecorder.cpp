@@ -0,0 +1,221 @@
+#include <eeros/control/SignalRecorder.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/hal/HAL.hpp>
+#include <algorithm>
+#include <chrono>
+
+using namespace eeros::control;
+
+namespace {
+	const char magic[8] = {'E', 'E', 'R', 'O', 'S', 'R', 'E', 'C'};
+	const uint32_t version = 1;
+
+	template < typename T >
+	void write(std::ostream& os, T value) {
+		os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template < typename T >
+	T read(std::istream& is) {
+		T value;
+		if (!is.read(reinterpret_cast<char*>(&value), sizeof(T))) throw eeros::Fault("record file is truncated");
+		return value;
+	}
+}
+
+SignalRecorder::SignalRecorder(std::size_t capacity)
+	: capacity(std::max<std::size_t>(capacity, 1)), recordSize(0), head(0), tail(0), overflows(0),
+	  recording(false), cycle(0), log(logger::Logger::getLogger('C')) { }
+
+SignalRecorder::~SignalRecorder() {
+	stop();
+}
+
+void SignalRecorder::addPeripheralInputs(TimeDomain& td) {
+	auto& blocks = td.getBlocks();
+	for (auto& p : peripherals()) {
+		if (std::find(blocks.begin(), blocks.end(), p.block) != blocks.end()) p.add(*this, p.output, p.id);
+	}
+}
+
+const std::vector<RecordChannel>& SignalRecorder::getChannels() const {
+	return infos;
+}
+
+void SignalRecorder::start(std::string fileName) {
+	if (isRecording()) throw Fault("recorder '" + getName() + "' is already recording");
+	file.open(fileName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) throw Fault("could not open record file '" + fileName + "'");
+
+	recordSize = sizeof(uint64_t);
+	for (auto& c : channels) recordSize += sizeof(timestamp_t) + c.info.size;
+	file.write(magic, sizeof(magic));
+	write<uint32_t>(file, version);
+	write<uint32_t>(file, channels.size());
+	write<uint32_t>(file, recordSize);
+	for (auto& c : channels) {
+		write<uint16_t>(file, c.info.name.size());
+		file.write(c.info.name.data(), c.info.name.size());
+		write<uint8_t>(file, static_cast<uint8_t>(c.info.type));
+		write<uint8_t>(file, c.info.peripheral);
+		write<uint32_t>(file, c.info.size);
+	}
+
+	buffer.reset(new uint8_t[capacity * recordSize]);
+	head = 0;
+	tail = 0;
+	overflows = 0;
+	cycle = 0;
+	recording.store(true, std::memory_order_release);
+	writer = std::thread(&SignalRecorder::run_writer, this);
+	log.info() << "recording " << channels.size() << " signals to '" << fileName << "'";
+}
+
+void SignalRecorder::stop() {
+	if (!recording.exchange(false)) return;
+	if (writer.joinable()) writer.join();
+	file.close();
+	log.info() << "recorded " << getNofRecords() << " cycles, " << getOverflows() << " dropped";
+}
+
+bool SignalRecorder::isRecording() const {
+	return recording.load(std::memory_order_acquire);
+}
+
+uint64_t SignalRecorder::getNofRecords() const {
+	return tail.load(std::memory_order_acquire);
+}
+
+uint64_t SignalRecorder::getOverflows() const {
+	return overflows.load(std::memory_order_relaxed);
+}
+
+void SignalRecorder::run() {
+	if (!recording.load(std::memory_order_acquire)) return;
+	uint64_t n = cycle++;
+	uint64_t h = head.load(std::memory_order_relaxed);
+	if (h - tail.load(std::memory_order_acquire) >= capacity) {
+		overflows.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	uint8_t* r = &buffer[(h % capacity) * recordSize];
+	std::memcpy(r, &n, sizeof(n));
+	r += sizeof(n);
+	for (auto& c : channels) {
+		c.capture(c.signal, r);
+		r += sizeof(timestamp_t) + c.info.size;
+	}
+	head.store(h + 1, std::memory_order_release);
+}
+
+void SignalRecorder::unregisterPeripheral(Block* block) {
+	auto& p = peripherals();
+	p.erase(std::remove_if(p.begin(), p.end(), [block] (const Peripheral& e) { return e.block == block; }), p.end());
+}
+
+std::vector<SignalRecorder::Peripheral>& SignalRecorder::peripherals() {
+	static std::vector<Peripheral> list;
+	return list;
+}
+
+void SignalRecorder::run_writer() {
+	while (true) {
+		bool stopping = !recording.load(std::memory_order_acquire);
+		uint64_t t = tail.load(std::memory_order_relaxed);
+		uint64_t h = head.load(std::memory_order_acquire);
+		for (; t < h; t++) {
+			file.write(reinterpret_cast<const char*>(&buffer[(t % capacity) * recordSize]), recordSize);
+			tail.store(t + 1, std::memory_order_release);
+		}
+		if (stopping) break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	file.flush();
+}
+
+SignalReplay::SignalReplay(std::string fileName) : recordSize(0), nofRecords(0), missing(0) {
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open()) throw Fault("could not open record file '" + fileName + "'");
+	char m[sizeof(magic)];
+	if (!file.read(m, sizeof(m)) || !std::equal(m, m + sizeof(m), magic)) throw Fault("'" + fileName + "' is not a record file");
+	if (read<uint32_t>(file) != version) throw Fault("record file '" + fileName + "' has an unknown version");
+	uint32_t nofChannels = read<uint32_t>(file);
+	recordSize = read<uint32_t>(file);
+	std::size_t offset = sizeof(uint64_t);
+	for (uint32_t i = 0; i < nofChannels; i++) {
+		RecordChannel c;
+		c.name.resize(read<uint16_t>(file));
+		if (!file.read(&c.name[0], c.name.size())) throw Fault("record file is truncated");
+		c.type = static_cast<RecordType>(read<uint8_t>(file));
+		c.peripheral = read<uint8_t>(file) != 0;
+		c.size = read<uint32_t>(file);
+		channels.push_back(c);
+		offsets.push_back(offset);
+		offset += sizeof(timestamp_t) + c.size;
+	}
+	if (offset != recordSize) throw Fault("record file '" + fileName + "' is corrupt");
+
+	data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	nofRecords = data.size() / recordSize;
+	if (nofRecords == 0) throw Fault("record file '" + fileName + "' holds no records");
+	uint64_t first, last;
+	std::memcpy(&first, record(0), sizeof(first));
+	std::memcpy(&last, record(nofRecords - 1), sizeof(last));
+	missing = last - first + 1 - nofRecords;
+}
+
+const std::vector<RecordChannel>& SignalReplay::getChannels() const {
+	return channels;
+}
+
+uint64_t SignalReplay::getNofRecords() const {
+	return nofRecords;
+}
+
+uint64_t SignalReplay::getMissingRecords() const {
+	return missing;
+}
+
+void SignalReplay::install() {
+	for (auto& c : channels) {
+		if (!c.peripheral) continue;
+		switch (c.type) {
+			case RecordType::boolean: install<bool>(c.name); break;
+			case RecordType::int8: install<int8_t>(c.name); break;
+			case RecordType::uint8: install<uint8_t>(c.name); break;
+			case RecordType::int16: install<int16_t>(c.name); break;
+			case RecordType::uint16: install<uint16_t>(c.name); break;
+			case RecordType::int32: install<int32_t>(c.name); break;
+			case RecordType::uint32: install<uint32_t>(c.name); break;
+			case RecordType::int64: install<int64_t>(c.name); break;
+			case RecordType::uint64: install<uint64_t>(c.name); break;
+			case RecordType::float32: install<float>(c.name); break;
+			case RecordType::float64: install<double>(c.name); break;
+			case RecordType::other: break;	// type unknown, has to be installed explicitly
+		}
+	}
+}
+
+bool SignalReplay::isFinished() const {
+	for (auto c : cursors)
+		if (c->next.load(std::memory_order_relaxed) < nofRecords) return false;
+	return true;
+}
+
+std::size_t SignalReplay::find(const std::string& name, std::size_t size) const {
+	for (std::size_t i = 0; i < channels.size(); i++) {
+		if (channels[i].name != name) continue;
+		if (channels[i].size != size) throw Fault("recorded channel '" + name + "' has a different size");
+		return i;
+	}
+	throw Fault("channel '" + name + "' not recorded");
+}
+
+const uint8_t* SignalReplay::record(uint64_t n) const {
+	if (n >= nofRecords) n = nofRecords - 1;
+	return &data[n * recordSize];
+}
+
+void SignalReplay::add(hal::InputInterface* input) {
+	hal::HAL::instance().addInput(input);
+}
@@ -1,9 +1,28 @@
 #include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Block.hpp>
+#include <eeros/core/CycleTime.hpp>
+#include <eeros/core/RealtimeCheck.hpp>
+#include <eeros/core/Tracer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <set>
 
 using namespace eeros::control;
 
+namespace {
+	std::string blockName(eeros::Runnable* runnable) {
+		auto block = dynamic_cast<Block*>(runnable);
+		if (block == nullptr || block->getName().empty()) return "<unnamed>";
+		return block->getName();
+	}
+}
+
 TimeDomain::TimeDomain(std::string name, double period, bool realtime) :
-	name(name), period(period), realtime(realtime), safetySystem(nullptr), safetyEvent(nullptr) {
+	name(name), period(period), realtime(realtime), log(logger::Logger::getLogger('C')), 
+	safetySystem(nullptr), safetyEvent(nullptr) {
 	// nothing to do
 }
 
@@ -11,6 +30,10 @@ std::string TimeDomain::getName() {
 	return name;
 }
 
+const std::list<eeros::Runnable*>& TimeDomain::getBlocks() {
+	return blocks;
+}
+
 double TimeDomain::getPeriod() {
 	return period;
 }
@@ -26,8 +49,20 @@ void TimeDomain::registerSafetyEvent(SafetySystem& ss, SafetyEvent& e) {
 
 void TimeDomain::run() {
 	if(!running) return;
+	Tracer::Scope scope(TraceCategory::timeDomain, name.c_str());
+	CycleTime::Scope cycle(cycleTime ? System::getTimeNs() : CycleTime::unset);
 	try {
-		for(auto block : blocks) block->run();
+		if (compiled && parallel) parallel->run();
+		else if (compiled && (Tracer::isEnabled(TraceCategory::block) || RealtimeCheck::isEnabled())) {
+			for (std::size_t i = 0; i < schedule.size(); i++) {
+				RealtimeCheck::Location location(scheduleNames[i].c_str());
+				Tracer::begin(TraceCategory::block, scheduleNames[i].c_str());
+				schedule[i]->run();
+				Tracer::end(TraceCategory::block, scheduleNames[i].c_str());
+			}
+		}
+		else if (compiled) for (auto block : schedule) block->run();
+		else for (auto block : blocks) block->run();
 	} catch (NotConnectedFault const& e) {
 		if(safetySystem != nullptr && safetyEvent != nullptr) {
 			safetySystem->triggerEvent(*safetyEvent);
@@ -50,24 +85,272 @@ void TimeDomain::stop() {
 }
 
 void TimeDomain::addBlock(eeros::Runnable* block) {
+	compiled = false;
 	blocks.push_back(block);
 }
 
 void TimeDomain::addBlock(eeros::Runnable& block) {
+	compiled = false;
 	blocks.push_back(&block);
 }
 
 void TimeDomain::removeBlock(eeros::Runnable* block) {
+	compiled = false;
 	blocks.remove(block);
 }
 
 void TimeDomain::removeBlock(eeros::Runnable& block) {
-	blocks.remove(&block);
+	removeBlock(&block);
+}
+
+bool TimeDomain::compile() {
+	std::vector<Runnable*> nodes(blocks.begin(), blocks.end());
+	std::size_t n = nodes.size();
+	
+	// build the dependency graph, an edge points from the block delivering a signal to the block reading it
+	std::map<Block*, std::size_t> index;
+	for (std::size_t i = 0; i < n; i++) {
+		auto block = dynamic_cast<Block*>(nodes[i]);
+		if (block != nullptr) index.emplace(block, i);
+	}
+	std::vector<std::vector<std::size_t>> successors(n);
+	std::vector<bool> selfLoop(n, false);
+	for (std::size_t i = 0; i < n; i++) {
+		auto block = dynamic_cast<Block*>(nodes[i]);
+		if (block == nullptr) continue;
+		for (auto input : block->getInputs()) {
+			if (!input->isConnected()) {
+				// blocks like a sum or a mux may leave inputs unused on purpose, reading them throws anyway
+				log.info() << "input of block '" << blockName(nodes[i]) << "' in time domain '" << name << "' is not connected";
+				continue;
+			}
+			auto source = index.find(input->getConnectedBlock());
+			if (source == index.end()) continue;	// not connected or fed from another time domain
+			if (source->second == i) selfLoop[i] = block->hasDirectFeedthrough();
+			else successors[source->second].push_back(i);
+		}
+	}
+	
+	// find strongly connected components (Tarjan), each component with more than one block is an algebraic loop
+	std::vector<int> order, low;
+	std::vector<bool> onStack;
+	std::vector<std::size_t> stack, component(n);
+	std::size_t nofComponents;
+	int counter;
+	std::function<void(std::size_t)> connect = [&](std::size_t v) {
+		order[v] = low[v] = counter++;
+		stack.push_back(v);
+		onStack[v] = true;
+		for (auto w : successors[v]) {
+			if (order[w] < 0) {
+				connect(w);
+				low[v] = std::min(low[v], low[w]);
+			} else if (onStack[w]) {
+				low[v] = std::min(low[v], order[w]);
+			}
+		}
+		if (low[v] == order[v]) {
+			std::size_t w;
+			do {
+				w = stack.back();
+				stack.pop_back();
+				onStack[w] = false;
+				component[w] = nofComponents;
+			} while (w != v);
+			nofComponents++;
+		}
+	};
+	auto findComponents = [&]() {
+		order.assign(n, -1);
+		low.assign(n, 0);
+		onStack.assign(n, false);
+		nofComponents = 0;
+		counter = 0;
+		for (std::size_t i = 0; i < n; i++) if (order[i] < 0) connect(i);
+	};
+	findComponents();
+	
+	// a block without direct feedthrough breaks a loop, it reads the values of the former cycle if it runs 
+	// ahead of the blocks delivering its inputs, outside of loops it keeps running after them
+	std::vector<std::pair<std::size_t, std::size_t>> delayed;
+	for (std::size_t i = 0; i < n; i++) {
+		auto& s = successors[i];
+		for (auto j = s.begin(); j != s.end();) {
+			if (component[i] == component[*j] && !dynamic_cast<Block*>(nodes[*j])->hasDirectFeedthrough()) {
+				delayed.emplace_back(i, *j);
+				j = s.erase(j);
+			} else j++;
+		}
+	}
+	if (!delayed.empty()) findComponents();
+	
+	std::vector<std::vector<std::size_t>> members(nofComponents);
+	for (std::size_t i = 0; i < n; i++) members[component[i]].push_back(i);
+	
+	bool loopFree = true;
+	for (auto& m : members) {
+		if (m.size() > 1 || selfLoop[m[0]]) {
+			loopFree = false;
+			auto e = log.warn();
+			e << "algebraic loop in time domain '" << name << "' with blocks ";
+			for (std::size_t i = 0; i < m.size(); i++) e << (i > 0 ? ", '" : "'") << blockName(nodes[m[i]]) << "'";
+		}
+	}
+	
+	// sort the components topologically, independent components keep the order in which they were added
+	std::vector<std::vector<std::size_t>> componentSuccessors(nofComponents);
+	std::vector<std::size_t> pending(nofComponents, 0);
+	for (std::size_t i = 0; i < n; i++) {
+		for (auto j : successors[i]) {
+			if (component[i] == component[j]) continue;
+			componentSuccessors[component[i]].push_back(component[j]);
+			pending[component[j]]++;
+		}
+	}
+	std::set<std::pair<std::size_t, std::size_t>> ready;	// ordered by the first block of a component
+	for (std::size_t c = 0; c < nofComponents; c++) {
+		if (pending[c] == 0) ready.emplace(members[c][0], c);
+	}
+	std::vector<std::size_t> sorted;
+	sorted.reserve(n);
+	while (!ready.empty()) {
+		std::size_t c = ready.begin()->second;
+		ready.erase(ready.begin());
+		for (auto i : members[c]) sorted.push_back(i);
+		for (auto s : componentSuccessors[c]) {
+			if (--pending[s] == 0) ready.emplace(members[s][0], s);
+		}
+	}
+	schedule.clear();
+	scheduleNames.clear();
+	profiled.clear();
+	for (auto i : sorted) {
+		scheduleNames.push_back(blockName(nodes[i]));
+		if (profiling) {
+			profiled.emplace_back(new ProfiledBlock(nodes[i]));
+			schedule.push_back(profiled.back().get());
+		} else {
+			schedule.push_back(nodes[i]);
+		}
+	}
+	
+	// split the blocks into subgraphs which do not exchange signals and distribute them onto the threads
+	parallel.reset();
+	if (nofThreads > 1) {
+		std::vector<std::size_t> root(n);
+		std::iota(root.begin(), root.end(), 0);
+		auto find = [&root](std::size_t i) {
+			while (root[i] != i) i = root[i] = root[root[i]];
+			return i;
+		};
+		for (std::size_t i = 0; i < n; i++) {
+			for (auto j : successors[i]) root[find(i)] = find(j);
+		}
+		for (auto& d : delayed) root[find(d.first)] = find(d.second);	// still exchange signals
+		std::map<std::size_t, std::size_t> subgraphOf;	// root -> subgraph, numbered in order of appearance
+		std::vector<std::size_t> subgraphSize;
+		for (auto i : sorted) {
+			auto s = subgraphOf.emplace(find(i), subgraphSize.size());
+			if (s.second) subgraphSize.push_back(0);
+			subgraphSize[s.first->second]++;
+		}
+		std::vector<std::size_t> bySize(subgraphSize.size());
+		std::iota(bySize.begin(), bySize.end(), 0);
+		std::stable_sort(bySize.begin(), bySize.end(), [&](std::size_t a, std::size_t b) { return subgraphSize[a] > subgraphSize[b]; });
+		std::size_t nofPartitions = std::min<std::size_t>(nofThreads, subgraphSize.size());
+		std::vector<std::size_t> partitionOf(subgraphSize.size()), load(nofPartitions, 0);
+		for (auto s : bySize) {	// largest subgraph onto the least loaded partition
+			auto p = std::min_element(load.begin(), load.end()) - load.begin();
+			partitionOf[s] = p;
+			load[p] += subgraphSize[s];
+		}
+		if (nofPartitions > 1) {
+			std::vector<task::TaskList> partitions(nofPartitions);
+			for (std::size_t k = 0; k < sorted.size(); k++) partitions[partitionOf[subgraphOf[find(sorted[k])]]].add(schedule[k]);
+			parallel.reset(new task::Parallel(partitions, cpus, spinCount));
+			log.trace() << "time domain '" << name << "' runs " << nofPartitions << " partitions in parallel";
+		}
+	}
+	
+	compiled = true;
+	log.trace() << "compiled time domain '" << name << "' with " << schedule.size() << " blocks";
+	return loopFree;
+}
+
+void TimeDomain::setParallel(unsigned nofThreads, std::vector<int> cpus, unsigned spinCount) {
+	compiled = false;
+	this->nofThreads = nofThreads;
+	this->cpus = cpus;
+	this->spinCount = spinCount;
+}
+
+std::size_t TimeDomain::getNofPartitions() {
+	if (parallel) return parallel->getNofPartitions();
+	return 1;
+}
+
+std::vector<int> TimeDomain::getParallelCpus() {
+	return cpus;
+}
+
+bool TimeDomain::isCompiled() {
+	return compiled;
+}
+
+void TimeDomain::ProfiledBlock::run() {
+	auto start = std::chrono::steady_clock::now();
+	block->run();
+	auto stop = std::chrono::steady_clock::now();
+	histogram.add(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+}
+
+void TimeDomain::setProfiling(bool enabled) {
+	compiled = false;
+	profiling = enabled;
 }
 
-// void TimeDomain::sortBlocks() {
-// 	// TODO
-// }
+bool TimeDomain::getProfiling() {
+	return profiling;
+}
+
+void TimeDomain::setCycleTime(bool enabled) {
+	cycleTime = enabled;
+}
+
+bool TimeDomain::getCycleTime() {
+	return cycleTime;
+}
+
+std::vector<BlockProfile> TimeDomain::getProfile() {
+	std::vector<BlockProfile> result;
+	std::unique_ptr<Histogram::Snapshot> s(new Histogram::Snapshot());
+	for (auto& p : profiled) {
+		p->histogram.snapshot(*s);
+		BlockProfile b;
+		b.name = blockName(p->block);
+		b.count = s->count;
+		b.min = s->min * 1e-9;
+		b.mean = s->mean() * 1e-9;
+		b.max = s->max * 1e-9;
+		b.p99 = s->percentile(99) * 1e-9;
+		result.push_back(b);
+	}
+	std::stable_sort(result.begin(), result.end(), [](const BlockProfile& a, const BlockProfile& b) { return a.mean > b.mean; });
+	return result;
+}
+
+void TimeDomain::resetProfile() {
+	for (auto& p : profiled) p->histogram.reset();
+}
+
+void TimeDomain::logProfile(std::size_t count) {
+	auto profile = getProfile();
+	log.info() << "profile of time domain '" << name << "', " << std::min(count, profile.size()) << " of " << profile.size() << " blocks by mean execution time [us]";
+	for (std::size_t i = 0; i < profile.size() && i < count; i++) {
+		auto& b = profile[i];
+		log.info() << "  '" << b.name << "': mean = " << b.mean * 1e6 << ", min = " << b.min * 1e6 << ", max = " << b.max * 1e6 << ", p99 = " << b.p99 * 1e6 << ", count = " << b.count;
+	}
+}
 
 namespace eeros {
 	namespace control {
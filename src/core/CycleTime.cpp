@@ -0,0 +1,6 @@
+#include <eeros/core/CycleTime.hpp>
+
+using namespace eeros;
+
+constexpr uint64_t CycleTime::unset;
+thread_local uint64_t CycleTime::current = CycleTime::unset;
@@ -0,0 +1,54 @@
+#include <eeros/core/CycleTimer.hpp>
+#include <eeros/core/Fault.hpp>
+#include <errno.h>
+#include <cmath>
+
+#define NS_PER_SEC 1000000000
+
+using namespace eeros;
+
+CycleTimer::CycleTimer(double period, clockid_t clock)
+    : clock(clock), period(static_cast<uint64_t>(std::llround(period * NS_PER_SEC))), deadline(0), lateness(0) {
+  if (this->period == 0) throw Fault("period of cycle timer must not be 0");
+}
+
+void CycleTimer::start() {
+  deadline = now() + period;
+}
+
+void CycleTimer::sleep() {
+  struct timespec ts;
+  ts.tv_sec = deadline / NS_PER_SEC;
+  ts.tv_nsec = deadline % NS_PER_SEC;
+  while (clock_nanosleep(clock, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+}
+
+uint64_t CycleTimer::next() {
+  deadline += period;
+  uint64_t t = now();
+  lateness = (t > deadline) ? t - deadline : 0;
+  if (t <= deadline) return 0;
+  return (t - deadline) / period + 1;
+}
+
+void CycleTimer::skip(uint64_t cycles) {
+  deadline += cycles * period;
+}
+
+uint64_t CycleTimer::getDeadline() const {
+  return deadline;
+}
+
+uint64_t CycleTimer::getLateness() const {
+  return lateness;
+}
+
+uint64_t CycleTimer::getPeriod() const {
+  return period;
+}
+
+uint64_t CycleTimer::now() const {
+  struct timespec ts;
+  if (clock_gettime(clock, &ts) != 0) throw Fault("Failed to get time!");
+  return static_cast<uint64_t>(ts.tv_sec) * NS_PER_SEC + static_cast<uint64_t>(ts.tv_nsec);
+}
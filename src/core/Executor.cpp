@@ -5,6 +5,14 @@
 #include <memory>
 #include <cmath>
 #include <thread>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <cstring>
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
 #include <signal.h>
 #include <sched.h>
 #include <sys/mman.h>
@@ -12,6 +20,11 @@
 #include <unistd.h>
 
 #include <eeros/core/Executor.hpp>
+#include <eeros/core/CycleTimer.hpp>
+#include <eeros/core/RealtimeCheck.hpp>
+#include <eeros/core/Schedulability.hpp>
+#include <eeros/core/VirtualClock.hpp>
+#include <eeros/core/Tracer.hpp>
 #include <eeros/task/Async.hpp>
 #include <eeros/task/Lambda.hpp>
 #include <eeros/task/HarmonicTaskList.hpp>
@@ -30,16 +43,72 @@ namespace {
 
 using Logger = logger::Logger;
 
+const unsigned char stackPattern = 0xa5;
+__thread unsigned char *stackLow = nullptr;  // lowest address filled by prefault_stack()
+__thread unsigned char *stackTop = nullptr;
+
+// bounds of the stack of the calling thread, without its guard page
+bool getStack(unsigned char *&low, unsigned char *&top) {
+  pthread_attr_t attr;
+  if (pthread_getattr_np(pthread_self(), &attr) != 0) return false;
+  void *addr = nullptr;
+  std::size_t size = 0, guard = 0;
+  bool ok = pthread_attr_getstack(&attr, &addr, &size) == 0;
+  pthread_attr_getguardsize(&attr, &guard);
+  pthread_attr_destroy(&attr);
+  if (!ok) return false;
+  low = static_cast<unsigned char*>(addr) + guard;
+  // the stack of the main thread grows on demand, the kernel keeps a gap of 256 pages below it
+  if (getpid() == syscall(SYS_gettid)) low += 256 * sysconf(_SC_PAGESIZE);
+  top = static_cast<unsigned char*>(addr) + size;
+  return true;
+}
+
+// allocates the memory on the stack, so that the stack pointer is moved down before the pages are touched
+__attribute__((noinline)) void fillStack(std::size_t size) {
+  unsigned char *p = static_cast<unsigned char*>(alloca(size));
+  std::memset(p, stackPattern, size);
+  asm volatile("" : : "r"(p) : "memory");
+  stackLow = p;
+}
+
 struct TaskThread {
-  TaskThread(double period, task::Periodic &task, task::HarmonicTaskList tasks) 
-      : taskList(tasks), async(taskList, task.getRealtime(), task.getNice()) {
+  TaskThread(double period, task::Periodic &task, task::HarmonicTaskList tasks, bool timed) 
+      : name(task.getName()), periodic(&task), period(period), timed(timed), taskList(tasks), 
+        async(taskList, task.getRealtime(), task.getNice(), task.getCpus(), timed ? period : 0, task.getName(), task.getStackSize()) {
     async.counter.setPeriod(period);
     async.counter.monitors = task.monitors;
+    async.setSpinCount(task.getSpinCount());
+    if (task.getOverrunPolicy() == OverrunPolicy::triggerEvent) {
+      if (task.getOverrunEvent() == nullptr) throw std::runtime_error("no safety event set for overrun policy triggerEvent of '" + name + "'");
+      async.setOverrunPolicy(*task.getSafetySystem(), *task.getOverrunEvent());
+    } else {
+      async.setOverrunPolicy(task.getOverrunPolicy());
+    }
   }
+  std::string name;
+  task::Periodic *periodic;
+  double period;
+  bool timed;  // runs on a timer of its own instead of being triggered by its base task
   task::HarmonicTaskList taskList;
   task::Async async;
 };
 
+// parses a cpu list as used by the kernel, e.g. "1,4-6"
+std::set<int> parseCpuList(const std::string &list) {
+  std::set<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+    for (int i = first; i <= last; i++) cpus.insert(i);
+  }
+  return cpus;
+}
+
 template < typename F >
 void traverse(std::vector<task::Periodic> &tasks, F func) {
   for (auto &t: tasks) {
@@ -49,39 +118,52 @@ void traverse(std::vector<task::Periodic> &tasks, F func) {
   }
 }
 
-void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output);
+void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output, bool nonHarmonic, bool virtualTime, bool nested);
 
-void createThreads(Logger &log, std::vector<task::Periodic> &tasks, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, task::HarmonicTaskList &output) {
+// nested is set for the periodics run before or after another periodic
+void createThreads(Logger &log, std::vector<task::Periodic> &tasks, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, task::HarmonicTaskList &output, bool nonHarmonic, bool virtualTime, bool nested = false) {
   for (task::Periodic &t: tasks) {
-    createThread(log, t, baseTask, threads, output.tasks);
+    createThread(log, t, baseTask, threads, output.tasks, nonHarmonic, virtualTime, nested);
   }
 }
 
-void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output) {
+void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output, bool nonHarmonic, bool virtualTime, bool nested) {
   int k = static_cast<int>(task.getPeriod() / baseTask.getPeriod());
   double actualPeriod = k * baseTask.getPeriod();
   double deviation = std::abs(task.getPeriod() - actualPeriod) / task.getPeriod();
+  bool timed = nonHarmonic && deviation > 0.01;
   task::HarmonicTaskList taskList;
 
+  // checked before the thread is created, threads created so far are stopped when the list of threads is destroyed
+  if (timed && virtualTime)
+    throw std::runtime_error("periodic '" + task.getName() + "' with a timer of its own can not run in virtual time");
+  // a timer of its own would drop the order relative to the parent
+  if (timed && nested)
+    throw std::runtime_error("periodic '" + task.getName() + "' is run before or after '" + baseTask.getName() + "' but its period is not harmonic to it");
+
   if (task.before.size() > 0) {
-    createThreads(log, task.before, task, threads, taskList);
+    createThreads(log, task.before, task, threads, taskList, nonHarmonic, virtualTime, true);
   }
   taskList.add(task.getTask());
   if (task.after.size() > 0) {
-    createThreads(log, task.after, task, threads, taskList);
+    createThreads(log, task.after, task, threads, taskList, nonHarmonic, virtualTime, true);
   }
 
-  if (task.getRealtime())
-    log.trace() << "creating harmonic realtime task '" << task.getName()
+  if (timed)
+    EEROS_LOG_TRACE(log) << "creating " << (task.getRealtime() ? "realtime " : "") << "task '" << task.getName() 
+          << "' with period " << task.getPeriod() << " sec and priority " << ((int)(Executor::basePriority) - task.getNice())
+          << " on a timer of its own, not harmonic to '" << baseTask.getName() << "'";
+  else if (task.getRealtime())
+    EEROS_LOG_TRACE(log) << "creating harmonic realtime task '" << task.getName()
           << "' with period " << actualPeriod << " sec (k = "
           << k << ") and priority " << ((int)(Executor::basePriority) - task.getNice())
           << " based on '" << baseTask.getName() << "'";
   else
-    log.trace() << "creating harmonic task '" << task.getName() << "' with period "
+    EEROS_LOG_TRACE(log) << "creating harmonic task '" << task.getName() << "' with period "
           << actualPeriod << " sec (k = " << k << ")"
           << " based on '" << baseTask.getName() << "'";
 
-  if (deviation > 0.01) throw std::runtime_error("period deviation too high");
+  if (deviation > 0.01 && !timed) throw std::runtime_error("period deviation too high");
 
   if (task.getRealtime() && task.getNice() <= 0)
     throw std::runtime_error("priority not set");
@@ -89,13 +171,49 @@ void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, s
   if (taskList.tasks.size() == 0)
     throw std::runtime_error("no task to execute");
 
-  threads.push_back(std::make_shared<TaskThread>(actualPeriod, task, taskList));
-  output.emplace_back(threads.back()->async, k);
+  if (timed) {
+    threads.push_back(std::make_shared<TaskThread>(task.getPeriod(), task, taskList, true));
+    return;
+  }
+  threads.push_back(std::make_shared<TaskThread>(actualPeriod, task, taskList, false));
+  output.emplace_back(threads.back()->async, k, std::max(task.getPhase(), 0));
+}
+
+// response time analysis of the executor thread and all realtime threads, threads pinned to the same cores are analysed together
+template < typename F >
+bool analyseSchedulability(Logger &log, const char *source, double period, std::vector<int> cpus, double mainRunTime, std::vector<std::shared_ptr<TaskThread>> &threads, F runTime) {
+  std::map<std::vector<int>, Schedulability> cores;
+  std::sort(cpus.begin(), cpus.end());
+  cores[cpus].add("executor", period, mainRunTime, Executor::basePriority);
+  for (auto &t: threads) {
+    if (!t->periodic->getRealtime()) continue;
+    auto c = t->periodic->getCpus();
+    std::sort(c.begin(), c.end());
+    cores[c].add(t->name, t->period, runTime(*t), Executor::basePriority - t->periodic->getNice());
+  }
+  bool all = true;
+  for (auto &c: cores) {
+    bool schedulable = c.second.analyse();
+    all = all && schedulable;
+    std::ostringstream summary;
+    summary << "schedulability with " << source << " run times on cpus " << (c.first.empty() ? "any" : Executor::cpu_list(c.first)) 
+        << ": utilization " << c.second.getUtilization() * 100 << " % (rate-monotonic bound " << c.second.getUtilizationBound() * 100 << " %)";
+    if (schedulable) log.info() << summary.str();
+    else log.warn() << summary.str();
+    for (auto &t: c.second.getThreads()) {
+      if (t.schedulable) log.info() << "  '" << t.name << "' worst-case response time " << t.responseTime << " sec, period " << t.period << " sec";
+      else log.warn() << "  '" << t.name << "' may miss its deadline, worst-case response time exceeds its period of " << t.period << " sec";
+    }
+  }
+  return all;
 }
 }
 
 Executor::Executor() 
-    : period(0), mainTask(nullptr), syncWithEtherCatStackIsSet(false), 
+    : period(0), startupTimeout(5), mainTask(nullptr), dumpInterval(0), stackPrefault(1024 * 1024), heapReserve(0), heapSingleArena(false), schedulingMode(SchedulingMode::harmonic), 
+      schedulingMeasuringTime(0), staggering(false), 
+      staggerMeasuringTime(0), peakUtilization(0), virtualTime(false), overrunPolicy(OverrunPolicy::catchUp), 
+      safetySystem(nullptr), overrunEvent(nullptr), syncWithEtherCatStackIsSet(false), 
       syncWithRosTimeIsSet(false), syncWithRosTopicIsSet(false), 
       log(logger::Logger::getLogger('E')) { }
 
@@ -135,6 +253,60 @@ void Executor::setExecutorPeriod(double period) {
   setMainTask(*task);
 }
 
+void Executor::setCpus(std::vector<int> cpus) {
+  this->cpus = cpus;
+}
+
+void Executor::setCounterDump(double interval, std::string fileName) {
+  dumpInterval = interval;
+  dumpFile = fileName;
+}
+
+void Executor::setStackPrefault(std::size_t size) {
+  stackPrefault = size;
+}
+
+void Executor::setHeapReserve(std::size_t size, bool singleArena) {
+  heapReserve = size;
+  heapSingleArena = singleArena;
+}
+
+void Executor::setSchedulingMode(SchedulingMode mode, double measuringTime) {
+  schedulingMode = mode;
+  schedulingMeasuringTime = measuringTime;
+}
+
+void Executor::setStaggering(bool enabled, double measuringTime) {
+  staggering = enabled;
+  staggerMeasuringTime = measuringTime;
+}
+
+double Executor::getPeakUtilization() {
+  return peakUtilization.load();
+}
+
+void Executor::setVirtualTime(bool enabled) {
+  virtualTime = enabled;
+  if (enabled) VirtualClock::enable();
+  else VirtualClock::disable();
+}
+
+void Executor::setOverrunPolicy(OverrunPolicy policy) {
+  if (policy == OverrunPolicy::triggerEvent && overrunEvent == nullptr)
+    throw std::runtime_error("no safety event set for overrun policy triggerEvent");
+  overrunPolicy = policy;
+}
+
+void Executor::setOverrunPolicy(safety::SafetySystem &ss, safety::SafetyEvent &e) {
+  safetySystem = &ss;
+  overrunEvent = &e;
+  overrunPolicy = OverrunPolicy::triggerEvent;
+}
+
+void Executor::setStartupTimeout(double timeout) {
+  startupTimeout = timeout;
+}
+
 task::Periodic* Executor::getMainTask() {
   return mainTask;
 }
@@ -148,9 +320,41 @@ void Executor::add(control::TimeDomain &timedomain) {
   tasks.push_back(task);
 }
 
-void Executor::prefault_stack() {
-  unsigned char dummy[8*1024] = {};
-    (void)dummy;
+void Executor::prefault_stack(std::size_t size) {
+  unsigned char *low, *top;
+  if (!getStack(low, top)) return;
+  unsigned char here;
+  // leaves room for the frames of fillStack() and memset() and for signal handlers
+  const std::ptrdiff_t margin = 16 * 1024;
+  std::size_t available = (&here - low > margin) ? &here - low - margin : 0;
+  if (size == 0 || size > available) size = available;
+  stackTop = top;
+  if (size > 0) fillStack(size);
+}
+
+std::size_t Executor::get_stack_high_water() {
+  if (stackLow == nullptr) return 0;
+  const unsigned char *p = stackLow;
+  while (p < stackTop && *p == stackPattern) p++;
+  return stackTop - p;
+}
+
+std::size_t Executor::get_stack_size() {
+  unsigned char *low, *top;
+  if (!getStack(low, top)) return 0;
+  return top - low;
+}
+
+bool Executor::reserve_heap(std::size_t size, bool singleArena) {
+  if (mallopt(M_TRIM_THRESHOLD, -1) == 0 || mallopt(M_MMAP_MAX, 0) == 0) return false;
+  if (singleArena && mallopt(M_ARENA_MAX, 1) == 0) return false;
+  unsigned char *p = static_cast<unsigned char*>(malloc(size));
+  if (p == nullptr) return false;
+  long pageSize = sysconf(_SC_PAGESIZE);
+  for (std::size_t i = 0; i < size; i += pageSize) p[i] = 0;
+  asm volatile("" : : "r"(p) : "memory");
+  free(p);
+  return true;
 }
 
 bool Executor::lock_memory() {
@@ -163,6 +367,30 @@ bool Executor::set_priority(int nice) {
   return (sched_setscheduler(0, SCHED_FIFO, &schedulingParam) != -1);
 }
 
+bool Executor::set_affinity(const std::vector<int> &cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto c: cpus) CPU_SET(c, &set);
+  return (sched_setaffinity(0, sizeof(set), &set) != -1);
+}
+
+std::vector<int> Executor::get_affinity() {
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == -1) return cpus;
+  for (int c = 0; c < CPU_SETSIZE; c++) {
+    if (CPU_ISSET(c, &set)) cpus.push_back(c);
+  }
+  return cpus;
+}
+
+std::string Executor::cpu_list(const std::vector<int> &cpus) {
+  std::ostringstream os;
+  for (std::size_t i = 0; i < cpus.size(); i++) os << (i > 0 ? "," : "") << cpus[i];
+  return os.str();
+}
+
 void Executor::stop() {
   running = false;
   auto &instance = Executor::instance();
@@ -210,39 +438,231 @@ void Executor::assignPriorities() {
   }
 }
 
+void Executor::compileTimeDomains() {
+  auto compile = [] (task::Periodic *task) {
+    auto td = dynamic_cast<control::TimeDomain*>(&task->getTask());
+    if (td != nullptr) td->compile();
+  };
+  if (mainTask != nullptr) compile(mainTask);
+  traverse(tasks, compile);
+}
+
+void Executor::checkCpus() {
+  auto available = get_affinity();
+  std::set<int> allowed(available.begin(), available.end());
+  std::set<int> isolated;
+  std::ifstream file("/sys/devices/system/cpu/isolated");
+  std::string line;
+  if (file && std::getline(file, line)) isolated = parseCpuList(line);
+  EEROS_LOG_TRACE(log) << "available cpus " << cpu_list(available) << ", isolated cpus " << cpu_list(std::vector<int>(isolated.begin(), isolated.end()));
+
+  auto check = [&] (const std::string &name, const std::vector<int> &cpus) {
+    for (auto c: cpus) {
+      if (allowed.find(c) == allowed.end())
+        throw std::runtime_error("cpu " + std::to_string(c) + " of '" + name + "' is not available");
+      if (isolated.find(c) == isolated.end())
+        log.warn() << "cpu " << c << " of '" << name << "' is not isolated";
+    }
+  };
+  // worker threads of parallel time domains are pinned to cpus of their own
+  auto checkWorkers = [&check] (task::Periodic *task) {
+    auto td = dynamic_cast<control::TimeDomain*>(&task->getTask());
+    if (td != nullptr) check("workers of time domain " + td->getName(), td->getParallelCpus());
+  };
+  check("executor", cpus);
+  if (mainTask != nullptr) checkWorkers(mainTask);
+  traverse(tasks, [&check, &checkWorkers] (task::Periodic *task) {
+    check(task->getName(), task->getCpus());
+    checkWorkers(task);
+  });
+}
+
 void Executor::run() {
-  log.trace() << "starting executor with base period " << period << " sec and priority " << (int)(basePriority) << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
+  EEROS_LOG_TRACE(log) << "starting executor with base period " << period << " sec and priority " << (int)(basePriority) << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
 
   if (period == 0.0)
     throw std::runtime_error("period of executor not set");
 
-  log.trace() << "assigning priorities";
+  EEROS_LOG_TRACE(log) << "assigning priorities";
   assignPriorities();
 
+  EEROS_LOG_TRACE(log) << "compiling time domains";
+  compileTimeDomains();
+
+  EEROS_LOG_TRACE(log) << "checking cpus";
+  checkCpus();
+
+  // before the threads are created, so that with a single arena they allocate from the reserved memory
+  if (heapReserve > 0) {
+    if (reserve_heap(heapReserve, heapSingleArena)) {
+      EEROS_LOG_TRACE(log) << "reserved " << heapReserve << " bytes on the heap" << (heapSingleArena ? " in a single arena" : "");
+    } else log.error() << "could not reserve " << heapReserve << " bytes on the heap";
+  }
+
   Runnable *mainTask = nullptr;
 
   if (this->mainTask != nullptr) {
     mainTask = &this->mainTask->getTask();
-    log.trace() << "setting '" << this->mainTask->getName() << "' as main task";
+    EEROS_LOG_TRACE(log) << "setting '" << this->mainTask->getName() << "' as main task";
   }
 
   std::vector<std::shared_ptr<TaskThread>> threads; // smart pointer used because async objects must not be copied
   task::HarmonicTaskList taskList;
   task::Periodic executorTask("executor", period, this, true);
 
-  counter.monitors = this->mainTask->monitors;
+  double mainRunTime = 0;  // expected run time of the main task in seconds
+  if (this->mainTask != nullptr) {
+    counter.monitors = this->mainTask->monitors;
+    mainRunTime = this->mainTask->getRunTime();
+  }
+
+  createThreads(log, tasks, executorTask, threads, taskList, schedulingMode == SchedulingMode::rateMonotonic, virtualTime);
+
+  // thread of every harmonic run by this thread, run times are kept in seconds
+  std::vector<TaskThread*> harmonics;
+  for (auto &h: taskList.tasks) {
+    for (auto &t: threads) if (&t->async == h.getTask()) harmonics.push_back(t.get());
+  }
+  std::vector<double> runTimes(taskList.tasks.size(), 0.0);
+  std::vector<bool> fixedPhases(taskList.tasks.size(), false);
+  auto stagger = [this, &harmonics, &fixedPhases] (task::HarmonicTaskList &list, const std::vector<double> &runTimes, double mainRunTime, const char *source) {
+    double before = list.getPeakLoad(runTimes);
+    list.stagger(runTimes, fixedPhases);
+    double after = list.getPeakLoad(runTimes);
+    peakUtilization = (mainRunTime + after) / period;
+    log.info() << "staggered " << list.tasks.size() << " periodics by " << source << " run times, worst-case utilization of a base period "
+               << (mainRunTime + before) / period * 100 << " % before, " << (mainRunTime + after) / period * 100 << " % after";
+    for (std::size_t i = 0; i < harmonics.size(); i++) 
+      EEROS_LOG_TRACE(log) << "periodic '" << harmonics[i]->name << "' runs with phase " << list.tasks[i].getPhase();
+  };
+  if (staggering) {
+    double sum = 0;
+    int known = 0;
+    for (std::size_t i = 0; i < harmonics.size(); i++) {
+      fixedPhases[i] = harmonics[i]->periodic->getPhase() >= 0;
+      runTimes[i] = harmonics[i]->periodic->getRunTime();
+      if (runTimes[i] > 0) {
+        sum += runTimes[i];
+        known++;
+      }
+    }
+    if (known > 0) {
+      for (auto &r: runTimes) if (r <= 0) r = sum / known;
+      stagger(taskList, runTimes, mainRunTime, "expected");
+    } else {
+      std::fill(runTimes.begin(), runTimes.end(), 1.0);
+      taskList.stagger(runTimes, fixedPhases);
+      log.info() << "staggered " << taskList.tasks.size() << " periodics with equal weights, no run times known";
+    }
+  }
+  if (schedulingMode == SchedulingMode::rateMonotonic) {
+    bool known = mainRunTime > 0;
+    for (auto &t: threads) known = known || t->periodic->getRunTime() > 0;
+    if (known) analyseSchedulability(log, "expected", period, cpus, mainRunTime, threads, [] (TaskThread &t) { return t.periodic->getRunTime(); });
+    else EEROS_LOG_TRACE(log) << "no run times known, schedulability is analysed with measured run times only";
+  }
 
-  createThreads(log, tasks, executorTask, threads, taskList);
+  // the executor thread counts the cycles until the run times are measured, the stagger thread 
+  // assigns the phases on a copy of the task list and hands them back to the executor thread
+  uint64_t staggerCycles = (staggering && staggerMeasuringTime > 0) ? std::max<uint64_t>(std::llround(staggerMeasuringTime / period), 1) : 0;
+  std::atomic<bool> staggerMeasured(false);
+  std::atomic<bool> staggerAssigned(false);
+  bool staggerPending = staggerCycles > 0;
+  std::vector<int> staggeredPhases(taskList.tasks.size(), 0);
 
   using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
 
-  // TODO: implement this with ready-flag (wait for all threads to be ready instead of blind sleep)
-  std::this_thread::sleep_for(seconds(1)); // wait 1 sec to allow threads to be created
+  EEROS_LOG_TRACE(log) << "waiting for " << threads.size() << " threads to be ready";
+  auto deadline = std::chrono::steady_clock::now() + seconds(startupTimeout);
+  for (auto &t: threads) {
+    double remaining = seconds(deadline - std::chrono::steady_clock::now()).count();
+    if (!t->async.waitReady(std::max(remaining, 0.0))) {
+      log.fatal() << "thread of task '" << t->name << "' not ready after " << startupTimeout << " sec";
+      throw std::runtime_error("thread of task '" + t->name + "' not ready");
+    }
+  }
+
+  // started before the priority of this thread is raised, the dump thread is not realtime
+  std::thread dumpThread;
+  if (dumpInterval > 0) {
+    dumpThread = std::thread([this, &threads] {
+      std::ofstream file;
+      if (!dumpFile.empty()) file.open(dumpFile, std::ios::app);
+      auto dump = [this, &file] (const std::string &name, const PeriodicCounter &c) {
+        std::stringstream ss;
+        c.dump(ss);
+        if (file.is_open()) {
+          file << "counter '" << name << "'\n" << ss.str() << std::flush;
+          return;
+        }
+        std::string line;
+        while (std::getline(ss, line)) log.info() << "counter '" << name << "' " << line;
+      };
+      auto next = std::chrono::steady_clock::now();
+      while (running) {
+        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(seconds(dumpInterval));
+        while (running && std::chrono::steady_clock::now() < next) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (!running) break;
+        dump("executor", counter);
+        for (auto &t: threads) dump(t->name, t->async.counter);
+      }
+    });
+  }
+
+  // analyses the measured run times, runs without realtime priority like the dump thread
+  std::thread analysisThread;
+  if (schedulingMode == SchedulingMode::rateMonotonic && schedulingMeasuringTime > 0) {
+    analysisThread = std::thread([this, &threads] {
+      auto end = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(seconds(schedulingMeasuringTime));
+      while (running && std::chrono::steady_clock::now() < end) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      if (!running) return;
+      std::unique_ptr<PeriodicCounter::Snapshot> s(new PeriodicCounter::Snapshot());
+      counter.snapshot(*s);
+      double mainRunTime = s->run.max * 1e-9;
+      analyseSchedulability(log, "measured", period, cpus, mainRunTime, threads, [&s] (TaskThread &t) {
+        t.async.counter.snapshot(*s);
+        return s->run.max * 1e-9;
+      });
+    });
+  }
+
+  // reassigns the phases from the measured run times, runs without realtime priority like the dump thread
+  std::thread staggerThread;
+  if (staggerPending) {
+    // copied here, the executor thread changes the counters of the harmonics while running taskList
+    task::HarmonicTaskList staggerList(taskList);
+    staggerThread = std::thread([this, &harmonics, list = std::move(staggerList), &staggerMeasured, &staggerAssigned, &staggeredPhases, &stagger] () mutable {
+      std::vector<double> runTimes(list.tasks.size(), 0.0);
+      while (running && !staggerMeasured.load(std::memory_order_acquire)) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      if (!running) return;
+      std::unique_ptr<PeriodicCounter::Snapshot> s(new PeriodicCounter::Snapshot());
+      for (std::size_t i = 0; i < harmonics.size(); i++) {
+        harmonics[i]->async.counter.snapshot(*s);
+        runTimes[i] = s->run.mean() * 1e-9;
+      }
+      counter.snapshot(*s);
+      stagger(list, runTimes, s->run.mean() * 1e-9, "measured");
+      for (std::size_t i = 0; i < list.tasks.size(); i++) staggeredPhases[i] = list.tasks[i].getPhase();
+      staggerAssigned.store(true, std::memory_order_release);
+    });
+  }
 
-  if (!set_priority(0))
+  // threads on a timer of their own start together with the executor
+  for (auto &t: threads)
+    if (t->timed) t->async.run();
+
+  // in virtual time the executor waits for threads of lower priority in every cycle
+  if (virtualTime) {
+    EEROS_LOG_TRACE(log) << "running in virtual time, priority of executor thread not raised";
+  } else if (!set_priority(0))
     log.error() << "could not set realtime priority";
 
-  prefault_stack();
+  if (!cpus.empty() && !set_affinity(cpus))
+    log.error() << "could not pin executor thread to cpus " << cpu_list(cpus);
+  log.info() << "executor thread " << getpid() << ":" << syscall(SYS_gettid) << " runs on cpus " << cpu_list(get_affinity());
+
+  prefault_stack(stackPrefault);
+  Tracer::registerThread("executor");
 
   if (!lock_memory())
     log.error() << "could not lock memory in RAM";
@@ -250,7 +670,7 @@ void Executor::run() {
   bool useDefaultExecutor = true;
 #ifdef USE_ETHERCAT
   if (etherCATStack) {
-    log.trace() << "starting execution synced to etcherCAT stack";
+    EEROS_LOG_TRACE(log) << "starting execution synced to etcherCAT stack";
     if (syncWithRosTimeIsSet)	log.error() << "Can't use both etherCAT and RosTime to sync executor";
     if (syncWithRosTopicIsSet)	log.error() << "Can't use both etherCAT and RosTopic to sync executor";
     useDefaultExecutor = false;
@@ -267,7 +687,7 @@ void Executor::run() {
 #endif
 #ifdef USE_ROS
   if (syncWithRosTimeIsSet) {
-    log.trace() << "starting execution synced to rosTime";
+    EEROS_LOG_TRACE(log) << "starting execution synced to rosTime";
     if (syncWithEtherCatStackIsSet)	log.error() << "Can't use both RosTime and etherCAT to sync executor";
     if (syncWithRosTopicIsSet)		log.error() << "Can't use both RosTime and RosTopic to sync executor";
     useDefaultExecutor = false;
@@ -289,7 +709,7 @@ void Executor::run() {
     
   }
   else if (syncWithRosTopicIsSet) {
-    log.trace() << "starting execution synced to gazebo";
+    EEROS_LOG_TRACE(log) << "starting execution synced to gazebo";
     if (syncWithRosTimeIsSet)		log.error() << "Can't use both RosTopic and RosTime to sync executor";
     if (syncWithEtherCatStackIsSet)	log.error() << "Can't use both RosTopic and etherCAT to sync executor";
     useDefaultExecutor = false;
@@ -328,29 +748,94 @@ void Executor::run() {
   }
 #endif
   if (useDefaultExecutor) {
-    log.trace() << "starting periodic execution";
-    auto next_cycle = std::chrono::steady_clock::now() + seconds(period);
+    EEROS_LOG_TRACE(log) << "starting periodic execution" << (virtualTime ? " in virtual time" : "");
+    uint64_t periodNs = std::llround(period * 1e9);
+    CycleTimer timer(period);
+    if (!virtualTime) timer.start();
     while (running) {
-      std::this_thread::sleep_until(next_cycle);
+      if (!virtualTime) timer.sleep();
 
       counter.tick();
-      taskList.run();
-      if (mainTask != nullptr)
-        mainTask->run();
+      Tracer::begin(TraceCategory::executor, "cycle");
+      {
+        RealtimeCheck::Context context("executor", !virtualTime);
+        taskList.run();
+        if (mainTask != nullptr)
+          mainTask->run();
+      }
+      Tracer::end(TraceCategory::executor, "cycle");
       counter.tock();
-      next_cycle += seconds(period);
+
+      if (staggerCycles > 0 && --staggerCycles == 0) staggerMeasured.store(true, std::memory_order_release);
+      if (staggerPending && staggerAssigned.load(std::memory_order_acquire)) {
+        for (std::size_t i = 0; i < staggeredPhases.size(); i++) taskList.tasks[i].setPhase(staggeredPhases[i]);
+        staggerPending = false;
+      }
+
+      if (virtualTime) {
+        // lockstep, the next cycle starts after all threads released in this cycle have finished
+        for (bool idle = false; !idle; ) {
+          idle = true;
+          for (auto &t: threads) {
+            if (!t->async.isIdle()) {
+              idle = false;
+              std::this_thread::yield();
+              break;
+            }
+          }
+        }
+        VirtualClock::advance(periodNs);
+        continue;
+      }
+
+      uint64_t missed = timer.next();
+      if (missed > 0) {
+        Tracer::instant(TraceCategory::executor, "overrun", missed);
+        counter.overrun(missed, timer.getLateness() * 1e-9);
+        if (overrunPolicy == OverrunPolicy::coalesce) timer.skip(missed - 1);
+        else if (overrunPolicy != OverrunPolicy::catchUp) timer.skip(missed);
+        if (overrunPolicy == OverrunPolicy::triggerEvent) safetySystem->triggerEvent(*overrunEvent);
+      }
     }
   }
 
-  log.trace() << "stopping all threads";
+  if (virtualTime) VirtualClock::disable();
+
+  EEROS_LOG_TRACE(log) << "stopping all threads";
 
   for (auto &t: threads)
     t->async.stop();
 
-  log.trace() << "joining all threads";
+  EEROS_LOG_TRACE(log) << "joining all threads";
 
   for (auto &t: threads)
     t->async.join();
 
-  log.trace() << "exiting executor " << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
+  if (dumpThread.joinable())
+    dumpThread.join();
+
+  if (analysisThread.joinable())
+    analysisThread.join();
+
+  if (staggerThread.joinable())
+    staggerThread.join();
+
+  auto logStack = [this] (const std::string &name, std::size_t highWater, std::size_t size) {
+    log.info() << "stack high-water mark of '" << name << "' is " << (highWater + 1023) / 1024 << " KiB of " << size / 1024 << " KiB";
+  };
+  logStack("executor", get_stack_high_water(), get_stack_size());
+  for (auto &t: threads)
+    logStack(t->name, t->async.getStackHighWater(), t->async.getStackSize());
+
+  if (RealtimeCheck::isEnabled())
+    RealtimeCheck::log(log);
+
+  auto logProfile = [] (task::Periodic *task) {
+    auto td = dynamic_cast<control::TimeDomain*>(&task->getTask());
+    if (td != nullptr && td->getProfiling()) td->logProfile();
+  };
+  if (this->mainTask != nullptr) logProfile(this->mainTask);
+  traverse(tasks, logProfile);
+
+  EEROS_LOG_TRACE(log) << "exiting executor " << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
 }
@@ -0,0 +1,77 @@
+#include <eeros/core/Histogram.hpp>
+#include <limits>
+
+using namespace eeros;
+
+constexpr std::size_t Histogram::nofBuckets;
+
+Histogram::Histogram() {
+  reset();
+}
+
+std::size_t Histogram::bucket(uint64_t value) {
+  if (value < nofSubBuckets) return value;
+  unsigned msb = 63 - __builtin_clzll(value);
+  if (msb >= rangeBits) return nofBuckets - 1;
+  unsigned shift = msb - subBucketBits;
+  return (shift + 1) * nofSubBuckets + ((value >> shift) - nofSubBuckets);
+}
+
+uint64_t Histogram::lowerBound(std::size_t bucket) {
+  std::size_t exponent = bucket / nofSubBuckets;
+  uint64_t mantissa = bucket % nofSubBuckets;
+  if (exponent == 0) return mantissa;
+  return (nofSubBuckets + mantissa) << (exponent - 1);
+}
+
+void Histogram::add(uint64_t value) {
+  buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+  if (value < min.load(std::memory_order_relaxed)) min.store(value, std::memory_order_relaxed);
+  if (value > max.load(std::memory_order_relaxed)) max.store(value, std::memory_order_relaxed);
+}
+
+void Histogram::reset() {
+  for (auto &b : buckets) b.store(0, std::memory_order_relaxed);
+  min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max.store(0, std::memory_order_relaxed);
+  sum.store(0, std::memory_order_relaxed);
+}
+
+void Histogram::snapshot(Snapshot& s) const {
+  s.count = 0;
+  for (std::size_t i = 0; i < nofBuckets; i++) {
+    s.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    s.count += s.buckets[i];
+  }
+  s.min = (s.count > 0) ? min.load(std::memory_order_relaxed) : 0;
+  s.max = max.load(std::memory_order_relaxed);
+  s.sum = sum.load(std::memory_order_relaxed);
+}
+
+void Histogram::restore(const Snapshot& s) {
+  for (std::size_t i = 0; i < nofBuckets; i++) buckets[i].store(s.buckets[i], std::memory_order_relaxed);
+  min.store((s.count > 0) ? s.min : std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max.store(s.max, std::memory_order_relaxed);
+  sum.store(s.sum, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::Snapshot::percentile(double percent) const {
+  if (count == 0) return 0;
+  uint64_t rank = static_cast<uint64_t>(percent / 100.0 * count + 0.5);
+  if (rank < 1) rank = 1;
+  if (rank >= count) return max;
+  uint64_t seen = 0;
+  for (std::size_t i = 0; i < nofBuckets; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      uint64_t upper = (i + 1 < nofBuckets) ? lowerBound(i + 1) - 1 : max;
+      return (upper < max) ? upper : max;
+    }
+  }
+  return max;
+}
+
+double Histogram::Snapshot::mean() const {
+  return (count > 0) ? static_cast<double>(sum) / count : 0.0;
+}
@@ -1,16 +1,58 @@
 #include <eeros/core/PeriodicCounter.hpp>
 #include <eeros/logger/Pretty.hpp>
 #include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/core/VirtualClock.hpp>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <thread>
 using namespace eeros;
 
+namespace {
+// follows virtual time if enabled, see VirtualClock
+std::chrono::steady_clock::time_point now() {
+  if (VirtualClock::isEnabled())
+    return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(VirtualClock::now()));
+  return std::chrono::steady_clock::now();
+}
+}
+
 PeriodicCounter::PeriodicCounter(double period, unsigned logger_category) :
-  reset_after(20), log(logger::Logger::getLogger('P')) {
+  reset_after(20), sequence(0), log(logger::Logger::getLogger('P')) {
     
   setPeriod(period);
-  start = clk::now();
+  start = now();
   first = true;
 }
 
+PeriodicCounter::PeriodicCounter(const PeriodicCounter &counter) : sequence(0), log(counter.log) {
+  *this = counter;
+}
+
+PeriodicCounter &PeriodicCounter::operator=(const PeriodicCounter &counter) {
+  if (this == &counter) return *this;
+  std::unique_ptr<Snapshot> s(new Snapshot());  // too large for small thread stacks
+  counter.snapshot(*s);
+  period = counter.period;
+  jitter = counter.jitter;
+  run = counter.run;
+  overruns.store(counter.overruns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  missed.store(counter.missed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  maxLateness.store(counter.maxLateness.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  monitors = counter.monitors;
+  counter_period = counter.counter_period;
+  reset_after = counter.reset_after;
+  first = counter.first;
+  reset_counter = counter.reset_counter;
+  start = counter.start;
+  last = counter.last;
+  periodHistogram.restore(s->period);
+  jitterHistogram.restore(s->jitter);
+  runHistogram.restore(s->run);
+  log = counter.log;
+  return *this;
+}
+
 void PeriodicCounter::setPeriod(double period) {
   counter_period = period;
   reset();
@@ -26,16 +68,23 @@ void PeriodicCounter::addDefaultMonitor(double tolerance) {
 
 void PeriodicCounter::tick() {
   last = start;
-  start = clk::now();
+  start = now();
 }
 
 void PeriodicCounter::tock() {
-  time_point stop = clk::now();
+  using ns = std::chrono::nanoseconds;
+  time_point stop = now();
   double new_run = std::chrono::duration<double>(stop - start).count();
   run.add(new_run);
   
+  uint32_t seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  runHistogram.add(std::chrono::duration_cast<ns>(stop - start).count());
+  
   if (first) {
     first = false;
+    sequence.store(seq + 2, std::memory_order_release);
     return;
   }
 
@@ -45,13 +94,33 @@ void PeriodicCounter::tock() {
   period.add(new_period);
   jitter.add(new_jitter);
   
+  periodHistogram.add(std::chrono::duration_cast<ns>(start - last).count());
+  jitterHistogram.add(static_cast<uint64_t>(std::abs(new_jitter) * 1e9));
+  sequence.store(seq + 2, std::memory_order_release);
+  
   for (auto &func: monitors) func(*this, log);
 }
 
+void PeriodicCounter::overrun(uint64_t missed, double lateness) {
+  overruns.fetch_add(1, std::memory_order_relaxed);
+  this->missed.fetch_add(missed, std::memory_order_relaxed);
+  if (lateness > maxLateness.load(std::memory_order_relaxed)) maxLateness.store(lateness, std::memory_order_relaxed);
+}
+
 void PeriodicCounter::reset() {
   period.reset();
   jitter.reset();
   run.reset();
+  overruns.store(0, std::memory_order_relaxed);
+  missed.store(0, std::memory_order_relaxed);
+  maxLateness.store(0, std::memory_order_relaxed);
+  uint32_t seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  periodHistogram.reset();
+  jitterHistogram.reset();
+  runHistogram.reset();
+  sequence.store(seq + 2, std::memory_order_release);
   reset_counter = (int)(reset_after / counter_period);
 }
 
@@ -73,13 +142,49 @@ void PeriodicCounter:: operator >> (eeros::logger::LogEntry &event) {
   event << "run   \t";
   l(event, run) << endl;
 
-  event << "count = " << period.count;
+  event << "count = " << period.count << ", overruns = " << overruns.load(std::memory_order_relaxed) << ", missed = " << missed.load(std::memory_order_relaxed)
+        << ", max lateness = " << pretty(maxLateness.load(std::memory_order_relaxed));
 }
 
 void PeriodicCounter:: operator >> (eeros::logger::LogEntry &&event) {
   *this >> event;
 }
 
+void PeriodicCounter::snapshot(Snapshot &snapshot) const {
+  while (true) {
+    uint32_t seq = sequence.load(std::memory_order_acquire);
+    if (seq & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    periodHistogram.snapshot(snapshot.period);
+    jitterHistogram.snapshot(snapshot.jitter);
+    runHistogram.snapshot(snapshot.run);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) == seq) return;
+  }
+}
+
+void PeriodicCounter::dump(std::ostream &os) const {
+  std::unique_ptr<Snapshot> s(new Snapshot());  // too large for small thread stacks
+  snapshot(*s);
+  std::ios::fmtflags flags(os.flags());
+  std::streamsize precision = os.precision();
+  auto line = [&os](const char *name, const Histogram::Snapshot &h) {
+    os << name << " [us]\t" << std::fixed << std::setprecision(1)
+       << "p50 = " << h.percentile(50) / 1000.0
+       << "\tp99 = " << h.percentile(99) / 1000.0
+       << "\tp99.9 = " << h.percentile(99.9) / 1000.0
+       << "\tmax = " << h.max / 1000.0
+       << "\tcount = " << h.count << '\n';
+  };
+  line("period", s->period);
+  line("jitter", s->jitter);
+  line("run   ", s->run);
+  os.flags(flags);
+  os.precision(precision);
+}
+
 
 void PeriodicCounter::addDefaultMonitor(std::vector<MonitorFunc> &monitors, double period, double tolerance){
   double Tmin = period * (1 - tolerance);
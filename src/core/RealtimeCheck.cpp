@@ -0,0 +1,245 @@
+#include <eeros/core/RealtimeCheck.hpp>
+#include <eeros/core/RingBuffer.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef EEROS_RT_CHECK
+#include <cerrno>
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+using namespace eeros;
+
+std::atomic<bool> RealtimeCheck::enabled(false);
+
+namespace {
+
+// plain data, so that accessing it from malloc() never runs a constructor
+struct ThreadState {
+  bool realtime;
+  bool reporting;          // set while reporting, calls made meanwhile are not checked
+  const char *thread;
+  const char *location;
+  uint64_t minorFaults;    // at the last sample
+  uint64_t majorFaults;
+};
+__thread ThreadState state;
+
+struct Event {
+  Violation kind;
+  uint64_t count;
+  char thread[32];
+  char location[48];
+};
+
+MpscRingBuffer<Event, 1024> events;
+std::atomic<uint64_t> lost(0);
+std::atomic<bool> abortOnViolation(false);
+
+std::mutex mtx;  // protects the collected counts
+std::map<std::tuple<Violation, std::string, std::string>, uint64_t> counts;
+
+void copy(char *dst, const char *src, std::size_t size) {
+  if (src == nullptr) src = "";
+  std::strncpy(dst, src, size - 1);
+  dst[size - 1] = 0;
+}
+
+void writeError(const char *s) {
+  if (::write(STDERR_FILENO, s, std::strlen(s)) < 0) return;
+}
+
+void faults(uint64_t &minor, uint64_t &major) {
+  struct rusage usage;
+  if (getrusage(RUSAGE_THREAD, &usage) != 0) return;
+  minor = usage.ru_minflt;
+  major = usage.ru_majflt;
+}
+
+// reports the page faults since the last sample for the current location
+void sample() {
+  uint64_t minor = state.minorFaults, major = state.majorFaults;
+  faults(minor, major);
+  if (minor > state.minorFaults) RealtimeCheck::report(Violation::minorFault, minor - state.minorFaults);
+  if (major > state.majorFaults) RealtimeCheck::report(Violation::majorFault, major - state.majorFaults);
+  state.minorFaults = minor;
+  state.majorFaults = major;
+}
+
+}
+
+void RealtimeCheck::enable(bool abort) {
+  abortOnViolation = abort;
+  enabled = true;
+}
+
+void RealtimeCheck::disable() {
+  enabled = false;
+}
+
+bool RealtimeCheck::isRealtime() {
+  return state.realtime && isEnabled();
+}
+
+void RealtimeCheck::report(Violation kind, uint64_t count) {
+  if (!state.realtime || state.reporting || !isEnabled()) return;
+  state.reporting = true;
+  if (abortOnViolation.load(std::memory_order_relaxed)) {
+    writeError("realtime violation: ");
+    writeError(getName(kind));
+    writeError(" in '");
+    writeError(state.thread);
+    if (state.location != nullptr) {
+      writeError("' at '");
+      writeError(state.location);
+    }
+    writeError("'\n");
+    std::abort();
+  }
+  Event e;
+  e.kind = kind;
+  e.count = count;
+  copy(e.thread, state.thread, sizeof(e.thread));
+  copy(e.location, state.location, sizeof(e.location));
+  if (!events.push(e)) lost.fetch_add(count, std::memory_order_relaxed);
+  state.reporting = false;
+}
+
+std::vector<ViolationCount> RealtimeCheck::collect() {
+  bool wasReporting = state.reporting;
+  state.reporting = true;  // the collecting thread may be realtime but must allocate here
+  std::vector<ViolationCount> result;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    Event e;
+    while (events.pop(e)) counts[std::make_tuple(e.kind, std::string(e.thread), std::string(e.location))] += e.count;
+    for (auto &c : counts) result.push_back({std::get<0>(c.first), std::get<1>(c.first), std::get<2>(c.first), c.second});
+  }
+  state.reporting = wasReporting;
+  return result;
+}
+
+uint64_t RealtimeCheck::getLost() {
+  return lost.load(std::memory_order_relaxed);
+}
+
+void RealtimeCheck::log(logger::Logger &log) {
+  auto violations = collect();
+  for (auto &v : violations) {
+    auto e = log.warn();
+    e << v.count << " x " << getName(v.kind) << " in realtime context '" << v.thread << "'";
+    if (!v.location.empty()) e << " at '" << v.location << "'";
+  }
+  if (getLost() > 0) log.warn() << getLost() << " realtime violations lost";
+  if (violations.empty()) log.info() << "no realtime violations detected";
+}
+
+const char* RealtimeCheck::getName(Violation kind) {
+  switch (kind) {
+    case Violation::allocation: return "allocation";
+    case Violation::deallocation: return "deallocation";
+    case Violation::mutexWait: return "mutex wait";
+    case Violation::minorFault: return "minor page fault";
+    case Violation::majorFault: return "major page fault";
+  }
+  return "unknown";
+}
+
+RealtimeCheck::Context::Context(const char *thread, bool realtime) : active(realtime && isEnabled()) {
+  if (!active) return;
+  wasRealtime = state.realtime;
+  previousThread = state.thread;
+  previousLocation = state.location;
+  if (wasRealtime) sample();
+  else faults(state.minorFaults, state.majorFaults);
+  state.thread = thread;
+  state.location = nullptr;
+  state.realtime = true;
+}
+
+RealtimeCheck::Context::~Context() {
+  if (!active) return;
+  sample();
+  state.realtime = wasRealtime;
+  state.thread = previousThread;
+  state.location = previousLocation;
+}
+
+RealtimeCheck::Location::Location(const char *name) : active(state.realtime && isEnabled()) {
+  if (!active) return;
+  sample();
+  previous = state.location;
+  state.location = name;
+}
+
+RealtimeCheck::Location::~Location() {
+  if (!active) return;
+  sample();
+  state.location = previous;
+}
+
+#ifdef EEROS_RT_CHECK
+// Interposes the allocation functions and pthread_mutex_lock() for the whole process.
+// The allocation functions forward to the ones of glibc, pthread_mutex_lock() to the
+// next definition found by the dynamic linker.
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *p, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *p);
+
+void *malloc(size_t size) {
+  if (state.realtime) RealtimeCheck::report(Violation::allocation);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+  if (state.realtime) RealtimeCheck::report(Violation::allocation);
+  return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size) {
+  if (state.realtime) RealtimeCheck::report(Violation::allocation);
+  return __libc_realloc(p, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  if (state.realtime) RealtimeCheck::report(Violation::allocation);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **p, size_t alignment, size_t size) {
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) return EINVAL;
+  if (state.realtime) RealtimeCheck::report(Violation::allocation);
+  *p = __libc_memalign(alignment, size);
+  return (*p == nullptr && size > 0) ? ENOMEM : 0;
+}
+
+void free(void *p) {
+  if (p != nullptr && state.realtime) RealtimeCheck::report(Violation::deallocation);
+  __libc_free(p);
+}
+
+int pthread_mutex_lock(pthread_mutex_t *m) {
+  using Lock = int (*)(pthread_mutex_t*);
+  static Lock next = nullptr;
+  if (state.realtime) {
+    int r = pthread_mutex_trylock(m);
+    if (r != EBUSY) return r;
+    RealtimeCheck::report(Violation::mutexWait);
+  }
+  if (next == nullptr) next = reinterpret_cast<Lock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+  return next(m);
+}
+
+}
+#endif
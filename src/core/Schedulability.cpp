@@ -0,0 +1,50 @@
+#include <eeros/core/Schedulability.hpp>
+#include <cmath>
+#include <limits>
+
+using namespace eeros;
+
+void Schedulability::add(std::string name, double period, double runTime, int priority) {
+  threads.push_back({name, period, runTime, priority, 0, false});
+}
+
+bool Schedulability::analyse() {
+  bool all = true;
+  for (auto &t: threads) {
+    // iterate R = C + sum of ceil(R / Tj) * Cj over all threads j which can preempt t
+    double r = t.runTime;
+    while (true) {
+      double next = t.runTime;
+      for (auto &j: threads) {
+        if (&j == &t || j.priority < t.priority) continue;
+        next += std::ceil(r / j.period - 1e-9) * j.runTime;
+      }
+      if (next > t.period) {
+        r = std::numeric_limits<double>::infinity();
+        break;
+      }
+      if (next <= r) break;
+      r = next;
+    }
+    t.responseTime = r;
+    t.schedulable = r <= t.period;
+    all = all && t.schedulable;
+  }
+  return all;
+}
+
+double Schedulability::getUtilization() const {
+  double u = 0;
+  for (auto &t: threads) u += t.runTime / t.period;
+  return u;
+}
+
+double Schedulability::getUtilizationBound() const {
+  double n = threads.size();
+  if (n == 0) return 1;
+  return n * (std::pow(2.0, 1.0 / n) - 1);
+}
+
+const std::vector<Schedulability::Thread>& Schedulability::getThreads() const {
+  return threads;
+}
@@ -1,5 +1,6 @@
 #include <eeros/core/System.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/VirtualClock.hpp>
 #include <time.h>
 
 #define NS_PER_SEC 1000000000
@@ -39,6 +40,8 @@ void System::useRosTime() {
 #endif
 
 uint64_t System::getTimeNs() {
+	if (VirtualClock::isEnabled()) return VirtualClock::now();
+
 #ifdef USE_ROS
 	if (rosTimeIsUsed) {
 		auto time = ros::Time::now();
@@ -0,0 +1,205 @@
+#include <eeros/core/Tracer.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace eeros;
+
+std::atomic<uint32_t> Tracer::categories(0);
+
+namespace {
+const char magic[8] = {'E', 'E', 'R', 'O', 'S', 'T', 'R', 'C'};
+const uint32_t version = 1;
+const char *categoryNames[] = {"executor", "task", "timeDomain", "block", "safety", "sequence", "user"};
+
+struct Buffer {
+  Buffer(std::string name, int64_t tid, std::size_t size) : name(name), tid(tid), size(size), events(new TraceEvent[size]), head(0) { }
+
+  void add(const TraceEvent &e) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    events[h & (size - 1)] = e;
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  // copies the events in the buffer, leaving out the ones overwritten meanwhile
+  std::vector<TraceEvent> snapshot() const {
+    uint64_t last = head.load(std::memory_order_acquire);
+    uint64_t first = (last > size) ? last - size : 0;
+    std::vector<TraceEvent> copy;
+    copy.reserve(last - first);
+    for (uint64_t i = first; i < last; i++) copy.push_back(events[i & (size - 1)]);
+    uint64_t now = head.load(std::memory_order_acquire);
+    uint64_t valid = (now >= size) ? now - size + 1 : 0;
+    if (valid > first) copy.erase(copy.begin(), copy.begin() + std::min<uint64_t>(valid - first, copy.size()));
+    return copy;
+  }
+
+  std::string name;
+  int64_t tid;
+  std::size_t size;
+  std::unique_ptr<TraceEvent[]> events;
+  std::atomic<uint64_t> head;
+};
+
+struct Thread {
+  std::string name;
+  int64_t tid;
+  std::vector<TraceEvent> events;
+};
+
+std::mutex mtx;
+std::vector<std::unique_ptr<Buffer>> buffers;  // kept after their threads end
+std::size_t capacity = 0;
+thread_local Buffer *buffer = nullptr;
+
+uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<Thread> collect() {
+  std::lock_guard<std::mutex> lock(mtx);
+  std::vector<Thread> threads;
+  for (auto &b : buffers) threads.push_back({b->name, b->tid, b->snapshot()});
+  return threads;
+}
+
+void writeString(std::ostream &os, const char *s) {
+  os << '"';
+  for (; *s != 0; s++) {
+    if (*s == '"' || *s == '\\') os << '\\' << *s;
+    else if (static_cast<unsigned char>(*s) < 0x20) os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*s) << std::dec;
+    else os << *s;
+  }
+  os << '"';
+}
+
+void writeJson(std::ostream &os, int64_t pid, const std::vector<Thread> &threads) {
+  const char *phases = "BEi";
+  bool first = true;
+  auto separate = [&] {
+    os << (first ? "\n" : ",\n");
+    first = false;
+  };
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (auto &t : threads) {
+    separate();
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << t.tid << ",\"args\":{\"name\":";
+    writeString(os, t.name.c_str());
+    os << "}}";
+    for (auto &e : t.events) {
+      separate();
+      os << "{\"name\":";
+      writeString(os, e.name);
+      unsigned c = static_cast<unsigned>(e.category);
+      os << ",\"cat\":\"" << (c < sizeof(categoryNames) / sizeof(categoryNames[0]) ? categoryNames[c] : "unknown") << "\""
+         << ",\"ph\":\"" << phases[e.phase % 3] << "\"";
+      if (e.phase == TraceEvent::instant) os << ",\"s\":\"t\"";
+      os << ",\"ts\":" << e.time / 1000 << '.' << std::setw(3) << std::setfill('0') << e.time % 1000 << std::setfill(' ')
+         << ",\"pid\":" << pid << ",\"tid\":" << t.tid << ",\"args\":{\"arg\":" << e.arg << "}}";
+    }
+  }
+  os << "\n]}\n";
+}
+
+template <typename T>
+void write(std::ostream &os, T value) {
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T read(std::istream &is) {
+  T value;
+  if (!is.read(reinterpret_cast<char *>(&value), sizeof(T))) throw Fault("trace file is truncated");
+  return value;
+}
+}
+
+void Tracer::enable(std::size_t size, uint32_t enabled) {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    capacity = 1;
+    while (capacity < size) capacity <<= 1;
+  }
+  categories.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::disable() {
+  categories.store(0, std::memory_order_relaxed);
+}
+
+void Tracer::registerThread(std::string name) {
+  if (categories.load(std::memory_order_relaxed) == 0) return;
+  std::lock_guard<std::mutex> lock(mtx);
+  if (buffer != nullptr) {
+    buffer->name = name;
+    return;
+  }
+  buffers.emplace_back(new Buffer(name, syscall(SYS_gettid), capacity));
+  buffer = buffers.back().get();
+}
+
+void Tracer::add(TraceEvent::Phase phase, TraceCategory category, const char *name, uint32_t arg) {
+  if (buffer == nullptr) registerThread("thread " + std::to_string(syscall(SYS_gettid)));
+  if (buffer == nullptr) return;  // disabled meanwhile
+  TraceEvent e;
+  e.time = now();
+  e.arg = arg;
+  e.phase = phase;
+  e.category = category;
+  std::strncpy(e.name, name, sizeof(e.name) - 1);
+  e.name[sizeof(e.name) - 1] = 0;
+  buffer->add(e);
+}
+
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto &b : buffers) b->head.store(0, std::memory_order_release);
+}
+
+void Tracer::writeChromeTrace(std::ostream &os) {
+  writeJson(os, getpid(), collect());
+}
+
+void Tracer::save(std::string fileName) {
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) throw Fault("could not open trace file '" + fileName + "'");
+  auto threads = collect();
+  file.write(magic, sizeof(magic));
+  write<uint32_t>(file, version);
+  write<int64_t>(file, getpid());
+  write<uint32_t>(file, threads.size());
+  for (auto &t : threads) {
+    write<uint16_t>(file, t.name.size());
+    file.write(t.name.data(), t.name.size());
+    write<int64_t>(file, t.tid);
+    write<uint64_t>(file, t.events.size());
+    file.write(reinterpret_cast<const char *>(t.events.data()), t.events.size() * sizeof(TraceEvent));
+  }
+}
+
+void Tracer::convert(std::string fileName, std::ostream &os) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file.is_open()) throw Fault("could not open trace file '" + fileName + "'");
+  char m[sizeof(magic)];
+  if (!file.read(m, sizeof(m)) || std::memcmp(m, magic, sizeof(m)) != 0) throw Fault("'" + fileName + "' is not a trace file");
+  if (read<uint32_t>(file) != version) throw Fault("trace file '" + fileName + "' has an unknown version");
+  int64_t pid = read<int64_t>(file);
+  std::vector<Thread> threads(read<uint32_t>(file));
+  for (auto &t : threads) {
+    t.name.resize(read<uint16_t>(file));
+    if (!file.read(&t.name[0], t.name.size())) throw Fault("trace file is truncated");
+    t.tid = read<int64_t>(file);
+    t.events.resize(read<uint64_t>(file));
+    if (!file.read(reinterpret_cast<char *>(t.events.data()), t.events.size() * sizeof(TraceEvent))) throw Fault("trace file is truncated");
+    for (auto &e : t.events) e.name[sizeof(e.name) - 1] = 0;
+  }
+  writeJson(os, pid, threads);
+}
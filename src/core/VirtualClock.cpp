@@ -0,0 +1,116 @@
+#include <eeros/core/VirtualClock.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+std::atomic<bool> enabled(false);
+std::atomic<uint64_t> virtualTime(0);
+std::mutex mtx;
+std::condition_variable wakeup;            // signals sleeping threads that virtual time has advanced
+std::condition_variable asleep;            // signals advance() that a thread went to sleep
+std::multiset<uint64_t> sleepers;          // end of the sleep of every sleeping thread
+int activeThreads = 0;                     // threads woken by advance() which have not gone to sleep again
+uint64_t currentGeneration = 0;            // incremented whenever advance() stops waiting for active threads
+std::chrono::duration<double> timeout(1.0);
+
+// a thread is active from the moment it is woken by advance() until it sleeps again or ends
+struct ThreadState {
+  bool active = false;
+  uint64_t generation = 0;
+  bool leave() {  // called with mtx locked
+    bool was = active && generation == currentGeneration;
+    if (was) {
+      activeThreads--;
+      asleep.notify_all();
+    }
+    active = false;
+    return was;
+  }
+  ~ThreadState() {
+    std::lock_guard<std::mutex> lock(mtx);
+    leave();
+  }
+};
+thread_local ThreadState state;
+}
+
+void VirtualClock::enable(uint64_t start) {
+  std::lock_guard<std::mutex> lock(mtx);
+  virtualTime = start;
+  enabled = true;
+}
+
+void VirtualClock::disable() {
+  std::lock_guard<std::mutex> lock(mtx);
+  enabled = false;
+  currentGeneration++;
+  activeThreads = 0;
+  wakeup.notify_all();
+}
+
+bool VirtualClock::isEnabled() {
+  return enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t VirtualClock::now() {
+  return virtualTime.load(std::memory_order_acquire);
+}
+
+void VirtualClock::advance(uint64_t ns) {
+  std::unique_lock<std::mutex> lock(mtx);
+  uint64_t t = virtualTime.load(std::memory_order_relaxed) + ns;
+  virtualTime.store(t, std::memory_order_release);
+  bool due = !sleepers.empty() && *sleepers.begin() <= t;
+  if (!due && activeThreads == 0) return;
+  if (due) wakeup.notify_all();
+  auto done = [t] { return activeThreads == 0 && (sleepers.empty() || *sleepers.begin() > t); };
+  if (!asleep.wait_for(lock, timeout, done)) {
+    currentGeneration++;  // stop waiting for the threads which are still active
+    activeThreads = 0;
+  }
+}
+
+void VirtualClock::sleep(double sec) {
+  if (!enabled) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(sec));
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mtx);
+  state.leave();
+  uint64_t end = virtualTime.load(std::memory_order_relaxed) + static_cast<uint64_t>(std::llround(sec * 1e9));
+  auto it = sleepers.insert(end);
+  asleep.notify_all();
+  wakeup.wait(lock, [end] { return !enabled || virtualTime.load(std::memory_order_relaxed) >= end; });
+  sleepers.erase(it);
+  if (enabled) {
+    activeThreads++;
+    state.active = true;
+    state.generation = currentGeneration;
+  }
+}
+
+void VirtualClock::setTimeout(double sec) {
+  std::lock_guard<std::mutex> lock(mtx);
+  timeout = std::chrono::duration<double>(sec);
+}
+
+VirtualClock::Blocking::Blocking() {
+  std::lock_guard<std::mutex> lock(mtx);
+  wasActive = state.leave();
+}
+
+VirtualClock::Blocking::~Blocking() {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (wasActive && enabled) {
+    activeThreads++;
+    state.active = true;
+    state.generation = currentGeneration;
+  }
+}
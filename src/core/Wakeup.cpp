@@ -0,0 +1,54 @@
+#include <eeros/core/Wakeup.hpp>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace eeros;
+
+namespace {
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex requires a plain int");
+
+inline int* address(std::atomic<int> &value) {
+  return reinterpret_cast<int*>(&value);
+}
+
+inline void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+}
+
+Wakeup::Wakeup(unsigned spinCount) : count(0), waiters(0), spinCount(spinCount) { }
+
+void Wakeup::post() {
+  count.fetch_add(1, std::memory_order_seq_cst);
+  if (waiters.load(std::memory_order_seq_cst) > 0)
+    syscall(SYS_futex, address(count), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+bool Wakeup::tryWait() {
+  int c = count.load(std::memory_order_relaxed);
+  while (c > 0) {
+    if (count.compare_exchange_weak(c, c - 1, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+  }
+  return false;
+}
+
+void Wakeup::wait() {
+  unsigned spin = spinCount.load(std::memory_order_relaxed);
+  for (unsigned i = 0; i < spin; i++) {
+    if (tryWait()) return;
+    relax();
+  }
+  while (!tryWait()) {
+    // the kernel only puts this thread to sleep if the counter is still 0, so no post() is lost
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    syscall(SYS_futex, address(count), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void Wakeup::setSpinCount(unsigned spinCount) {
+  this->spinCount.store(spinCount, std::memory_order_relaxed);
+}
@@ -0,0 +1,44 @@
+#include <eeros/logger/LogRecord.hpp>
+
+using namespace eeros::logger;
+
+namespace {
+	template < typename T >
+	T read(const char*& p) {
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		p += sizeof(T);
+		return value;
+	}
+}
+
+void LogRecord::format(std::ostream& os) const {
+	const char* p = text;
+	const char* e = text + length;
+	while (p < e) {
+		const char* plain = p;
+		while (p < e && static_cast<unsigned char>(*p) >= LogRecordBuffer::endOfMarkers) p++;
+		if (p > plain) os.write(plain, p - plain);
+		if (p == e) break;
+		char marker = *p++;
+		switch (marker) {
+			case LogRecordBuffer::escape:
+				if (p < e) os.write(p++, 1);
+				break;
+			case LogRecordStream::formatMarker: {
+				auto f = read<LogRecordStream::Format>(p);
+				os.flags(static_cast<std::ios_base::fmtflags>(f.flags));
+				os.precision(f.precision);
+				os.width(f.width);
+				os.fill(f.fill);
+				break;
+			}
+			case LogRecordStream::boolMarker: os << read<bool>(p); break;
+			case LogRecordStream::int32Marker: os << read<int32_t>(p); break;
+			case LogRecordStream::int64Marker: os << read<int64_t>(p); break;
+			case LogRecordStream::uint32Marker: os << read<uint32_t>(p); break;
+			case LogRecordStream::uint64Marker: os << read<uint64_t>(p); break;
+			case LogRecordStream::doubleMarker: os << read<double>(p); break;
+		}
+	}
+}
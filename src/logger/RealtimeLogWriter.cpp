@@ -0,0 +1,72 @@
+#include <eeros/logger/RealtimeLogWriter.hpp>
+
+using namespace eeros::logger;
+
+RealtimeLogWriter::RealtimeLogWriter(std::ostream& out, std::chrono::milliseconds interval) 
+    : StreamLogWriter(out), nofDropped(0), reportedDropped(0), interval(interval), finished(false),
+      thread(&RealtimeLogWriter::run, this) { }
+
+RealtimeLogWriter::RealtimeLogWriter(std::ostream& out, std::string logFile, std::chrono::milliseconds interval) 
+    : StreamLogWriter(out, logFile), nofDropped(0), reportedDropped(0), interval(interval), finished(false),
+      thread(&RealtimeLogWriter::run, this) { }
+
+RealtimeLogWriter::~RealtimeLogWriter() {
+  finished = true;
+  thread.join();
+}
+
+uint64_t RealtimeLogWriter::dropped() const {
+  return nofDropped.load(std::memory_order_relaxed);
+}
+
+bool RealtimeLogWriter::realtime() const {
+  return true;
+}
+
+void RealtimeLogWriter::commit(const LogRecord& record) {
+  if (!queue.push(record)) nofDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RealtimeLogWriter::run() {
+  while (!finished) {
+    if (!flush()) std::this_thread::sleep_for(interval);
+  }
+  while (flush());  // messages which were logged before destruction
+}
+
+bool RealtimeLogWriter::flush() {
+  static constexpr std::size_t batchSize = 16;
+  LogRecord records[batchSize];
+  std::size_t n = queue.pop(records, batchSize);
+  for (std::size_t i = 0; i < n; i++) write(records[i]);
+  
+  uint64_t d = dropped();
+  if (d != reportedDropped) {
+    LogRecord r;
+    r.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    r.level = LogLevel::WARN;
+    r.category = 0;
+    LogRecordStream rs(r);
+    rs.append(d - reportedDropped);
+    rs.append(" log messages dropped, realtime log queue full");
+    r.length = rs.length();
+    write(r);
+    reportedDropped = d;
+    out.flush();  // also if no message was written
+  }
+  else if (n > 0) out.flush();
+  return n > 0;
+}
+
+void RealtimeLogWriter::write(const LogRecord& r) {
+  std::ostringstream os;
+  auto time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(r.time)));
+  header(os, time, r.level, r.category);
+  std::ostringstream text;
+  r.format(text);
+  for (char c : text.str()) {
+    if (c == '\n') StreamLogWriter::endl(os);
+    else os << c;
+  }
+  StreamLogWriter::end(os);
+}
@@ -38,8 +38,11 @@ StreamLogWriter::~StreamLogWriter() {fileOut.close();}
 void StreamLogWriter::show(LogLevel level) { visible_level = level; }
 
 void StreamLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned category) {
+  header(os, std::chrono::system_clock::now(), level, category);
+}
+
+void StreamLogWriter::header(std::ostream& os, std::chrono::system_clock::time_point tx, LogLevel level, unsigned category) {
   tm localTime;
-  std::chrono::system_clock::time_point tx = std::chrono::system_clock::now();
   time_t now = std::chrono::system_clock::to_time_t(tx);
   localtime_r(&now, &localTime);
   const std::chrono::duration<double> tse = tx.time_since_epoch();
@@ -1,5 +1,6 @@
 #include <eeros/safety/SafetySystem.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/Tracer.hpp>
 
 namespace eeros {
 	namespace safety {
@@ -47,6 +48,7 @@ namespace eeros {
 		}
 		
 		void SafetySystem::triggerEvent(SafetyEvent event, SafetyContext* context) {
+			if(Tracer::isEnabled(TraceCategory::safety)) Tracer::instant(TraceCategory::safety, event.getDescription().c_str());
 			if(currentLevel) {
 				SafetyLevel* newLevel = currentLevel->getDestLevelForEvent(event, context == &privateContext);
 				if(newLevel != nullptr) {
@@ -80,6 +82,7 @@ namespace eeros {
 
 		void SafetySystem::run() {
 			// level must only change before safety system runs or after run method has finished
+			if(nextLevel != nullptr && nextLevel != currentLevel) Tracer::instant(TraceCategory::safety, nextLevel->description.c_str(), nextLevel->id);
 			if(nextLevel != nullptr) currentLevel = nextLevel; 
 			if(currentLevel != nullptr) {
 
@@ -115,6 +118,7 @@ namespace eeros {
 						oa->set();
 					}
 				}
+				if(nextLevel != nullptr && nextLevel != currentLevel) Tracer::instant(TraceCategory::safety, nextLevel->description.c_str(), nextLevel->id);
 				if(nextLevel != nullptr) currentLevel = nextLevel; 
 			}
 			else {
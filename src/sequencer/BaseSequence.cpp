@@ -1,6 +1,8 @@
 #include <eeros/sequencer/BaseSequence.hpp>
 #include <eeros/sequencer/Sequencer.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/VirtualClock.hpp>
+#include <eeros/core/Tracer.hpp>
 #include <unistd.h>
 
 namespace eeros {
@@ -29,7 +31,13 @@ int BaseSequence::action() {
     seq.nextStep = false;
   }
   std::lock_guard<std::mutex> lock(mtx);
+  Tracer::Scope scope(TraceCategory::sequence, name.c_str());
+  SequenceState traced = state;
   while (state != SequenceState::terminated) {
+    if (state != traced) {  // the state is passed as argument of the trace event
+      traced = state;
+      Tracer::instant(TraceCategory::sequence, name.c_str(), static_cast<uint32_t>(state));
+    }
     switch (state) {
       case SequenceState::idle: { // upon creation
         clearActiveMonitor();
@@ -51,7 +59,7 @@ int BaseSequence::action() {
         checkMonitors();    // check monitors of this sequence and all callers, execute exception if necessary
         if (state == SequenceState::restarting) continue; // stop any further actions when restarting
         if (checkExitCondition()) state = SequenceState::terminated;
-        if (state == SequenceState::running) usleep(pollingTime * 1000);  // wait only in case of normal execution
+        if (state == SequenceState::running) VirtualClock::sleep(pollingTime / 1000.0);  // wait only in case of normal execution
         break;
       }
       case SequenceState::paused: { // not used
@@ -95,14 +103,14 @@ void BaseSequence::checkMonitors() {
   }
 
   if (activeSeq != nullptr) {
-    log.trace() << "fired detected, prop = " << activeSeq->activeMonitor->behavior << ", handle all callers of " << name;
+    EEROS_LOG_TRACE(log) << "fired detected, prop = " << activeSeq->activeMonitor->behavior << ", handle all callers of " << name;
     for (BaseSequence* s : callerStack) {
-      log.trace() << "\thandle " << s->name << ", monitorFired = " << s->monitorFired << ", prop = " << activeSeq->activeMonitor->getBehavior();
+      EEROS_LOG_TRACE(log) << "\thandle " << s->name << ", monitorFired = " << s->monitorFired << ", prop = " << activeSeq->activeMonitor->getBehavior();
       if (!s->monitorFired) {
         SequenceProp prop = activeSeq->activeMonitor->getBehavior();
         if (prop == SequenceProp::abort || prop == SequenceProp::restart) {
           s->state = SequenceState::aborting;
-          log.trace() << "\tput " << s->name << " into state " << s->state;
+          EEROS_LOG_TRACE(log) << "\tput " << s->name << " into state " << s->state;
         }
       } else break;
     }
@@ -118,7 +126,7 @@ void BaseSequence::checkMonitors() {
  */
 BaseSequence* BaseSequence::checkMonitor(Monitor* m) {
   BaseSequence* firedSeq = nullptr;
-  log.trace() << "check monitor "  << m->name << " of " << m->getOwner()->name;
+  EEROS_LOG_TRACE(log) << "check monitor "  << m->name << " of " << m->getOwner()->name;
   if (m->checkCondition()) {
     BaseSequence* owner = m->getOwner();
     firedSeq = owner;
@@ -139,7 +147,7 @@ BaseSequence* BaseSequence::checkMonitor(Monitor* m) {
         case SequenceProp::restart: owner->state = SequenceState::restarting; break;
         default : break;
       }
-      log.trace() << "after exception, put " << owner->getName() << " into state " << owner->state;
+      EEROS_LOG_TRACE(log) << "after exception, put " << owner->getName() << " into state " << owner->state;
     }
   }
   return firedSeq;
@@ -150,7 +158,7 @@ void BaseSequence::addMonitor(Monitor* monitor) {monitors.push_back(monitor);}
 std::vector<Monitor*> BaseSequence::getMonitors() const {return monitors;}
 
 void BaseSequence::clearActiveMonitor() {
-  log.trace() << "clear active monitor in " << name;
+  EEROS_LOG_TRACE(log) << "clear active monitor in " << name;
   monitorFired = false;
   activeMonitor = nullptr;
 }
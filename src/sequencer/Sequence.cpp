@@ -1,6 +1,7 @@
 #include <eeros/sequencer/Sequence.hpp>
 #include <eeros/sequencer/Sequencer.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/VirtualClock.hpp>
 #include <unistd.h>
 #include <sys/syscall.h>
 #include <future>
@@ -60,6 +61,7 @@ int Sequence::getResult() {
 }
 
 void Sequence::wait() {
+  VirtualClock::Blocking blocking;
   if (fut.valid()) retVal = fut.get();
 }
 
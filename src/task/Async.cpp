@@ -1,3 +1,4 @@
+#include <chrono>
 #include <stdexcept>
 #include <sys/types.h>
 #include <sys/syscall.h>
@@ -5,17 +6,36 @@
 
 #include <eeros/task/Async.hpp>
 #include <eeros/core/Executor.hpp>
+#include <eeros/core/CycleTimer.hpp>
+#include <eeros/core/RealtimeCheck.hpp>
+#include <eeros/core/Tracer.hpp>
+#include <eeros/core/VirtualClock.hpp>
+#include <eeros/safety/SafetySystem.hpp>
 
 using namespace eeros::task;
 using namespace eeros::logger;
 
-Async::Async(Runnable &task, bool realtime , int nice) 
-    : task(task), realtime(realtime), nice(nice), thread(&Async::run_thread, this), 
-      finished(false), log(Logger::getLogger('A')) { }
+namespace {
+// follows virtual time if enabled, see VirtualClock
+uint64_t now() {
+  if (eeros::VirtualClock::isEnabled()) return eeros::VirtualClock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
 
-Async::Async(Runnable *task, bool realtime , int nice) 
-    : task(*task), realtime(realtime), nice(nice), thread(&Async::run_thread, this), 
-      finished(false), log(Logger::getLogger('A')) { }
+Async::Async(Runnable &task, bool realtime , int nice, std::vector<int> cpus, double period, std::string name, std::size_t stackSize) 
+    : task(task), name(name), realtime(realtime), nice(nice), cpus(cpus), period(period), overrunPolicy(OverrunPolicy::catchUp), 
+      safetySystem(nullptr), overrunEvent(nullptr), busy(false), started(false), pending(0), misses(0), missTime(0), finished(false), 
+      stackSize(stackSize), stackHighWater(0), log(Logger::getLogger('A')), joinable(false) {
+  create();
+}
+
+Async::Async(Runnable *task, bool realtime , int nice, std::vector<int> cpus, double period, std::string name, std::size_t stackSize) 
+    : task(*task), name(name), realtime(realtime), nice(nice), cpus(cpus), period(period), overrunPolicy(OverrunPolicy::catchUp), 
+      safetySystem(nullptr), overrunEvent(nullptr), busy(false), started(false), pending(0), misses(0), missTime(0), finished(false), 
+      stackSize(stackSize), stackHighWater(0), log(Logger::getLogger('A')), joinable(false) {
+  create();
+}
 
 Async::~Async() {
   stop();
@@ -23,16 +43,101 @@ Async::~Async() {
 }
 
 void Async::run() {
-  semaphore.post();
+  Tracer::instant(TraceCategory::task, name.c_str());
+  if (period > 0) {
+    // the first call starts the timer
+    if (!started.exchange(true, std::memory_order_acq_rel)) release();
+    return;
+  }
+  if (!busy.load(std::memory_order_acquire) && pending.load(std::memory_order_acquire) == 0) {
+    release();
+    return;
+  }
+  // the previous cycle has not finished yet, its deadline is missed
+  uint64_t none = 0;
+  missTime.compare_exchange_strong(none, now(), std::memory_order_relaxed);
+  misses.fetch_add(1, std::memory_order_release);
+  Tracer::instant(TraceCategory::task, "deadline miss");
+  switch (overrunPolicy) {
+    case OverrunPolicy::catchUp:
+      release();
+      break;
+    case OverrunPolicy::coalesce:
+      if (pending.load(std::memory_order_acquire) == 0) release();
+      break;
+    case OverrunPolicy::triggerEvent:
+      safetySystem->triggerEvent(*overrunEvent);
+      break;
+    case OverrunPolicy::skip:
+      break;
+  }
+}
+
+void Async::release() {
+  pending.fetch_add(1, std::memory_order_release);
+  wakeup.post();
+}
+
+bool Async::isIdle() const {
+  return pending.load(std::memory_order_acquire) == 0 && !busy.load(std::memory_order_acquire);
+}
+
+void Async::setSpinCount(unsigned spinCount) {
+  wakeup.setSpinCount(spinCount);
+}
+
+void Async::setOverrunPolicy(OverrunPolicy policy) {
+  if (policy == OverrunPolicy::triggerEvent && overrunEvent == nullptr)
+    throw std::runtime_error("no safety event set for overrun policy triggerEvent");
+  overrunPolicy = policy;
+}
+
+void Async::setOverrunPolicy(safety::SafetySystem &ss, safety::SafetyEvent &e) {
+  safetySystem = &ss;
+  overrunEvent = &e;
+  overrunPolicy = OverrunPolicy::triggerEvent;
 }
 
 void Async::stop() {
   finished = true;
-  semaphore.post();
+  wakeup.post();
 }
 
 void Async::join() {
-  if (thread.joinable()) thread.join();
+  if (!joinable) return;
+  pthread_join(thread, nullptr);
+  joinable = false;
+}
+
+std::size_t Async::getStackSize() const {
+  return stackSize;
+}
+
+std::size_t Async::getStackHighWater() const {
+  return stackHighWater;
+}
+
+// started with pthreads instead of std::thread, which can not set the stack size
+void Async::create() {
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  if (stackSize > 0 && pthread_attr_setstacksize(&attr, stackSize) != 0) {
+    pthread_attr_destroy(&attr);
+    throw std::runtime_error("invalid stack size " + std::to_string(stackSize) + " of thread '" + name + "'");
+  }
+  int r = pthread_create(&thread, &attr, &Async::start, this);
+  pthread_attr_destroy(&attr);
+  if (r != 0) throw std::runtime_error("could not create thread '" + name + "'");
+  joinable = true;
+}
+
+void* Async::start(void *async) {
+  static_cast<Async*>(async)->run_thread();
+  return nullptr;
+}
+
+bool Async::waitReady(double timeout_sec) {
+  return readySemaphore.wait(timeout_sec);
 }
 
 void Async::run_thread() {
@@ -40,10 +145,11 @@ void Async::run_thread() {
   const auto tid = syscall(SYS_gettid);
 
   Executor::prefault_stack();
+  stackSize = Executor::get_stack_size();
 
   if (realtime) {
     int priority = Executor::basePriority - nice;
-    log.trace() << "starting realtime thread " << pid << ":" << tid << " with priority " << priority;
+    EEROS_LOG_TRACE(log) << "starting realtime thread " << pid << ":" << tid << " with priority " << priority;
 
     if (!Executor::set_priority(nice))
       log.error() << "could not set realtime priority";
@@ -52,16 +158,66 @@ void Async::run_thread() {
       log.error() << "could not lock memory in RAM";
   }
   else {
-    log.trace() << "starting thread " << pid << ":" << tid;
+    EEROS_LOG_TRACE(log) << "starting thread " << pid << ":" << tid;
+  }
+
+  if (!cpus.empty() && !Executor::set_affinity(cpus))
+    log.error() << "could not pin thread " << pid << ":" << tid << " to cpus " << Executor::cpu_list(cpus);
+  log.info() << "thread " << pid << ":" << tid << " runs on cpus " << Executor::cpu_list(Executor::get_affinity());
+
+  Tracer::registerThread(name);
+  readySemaphore.post();
+  wakeup.wait();
+  if (period > 0) {
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    run_timed();
+  } else {
+    while (!finished) {
+      busy.store(true, std::memory_order_release);
+      pending.fetch_sub(1, std::memory_order_acq_rel);
+      counter.tick();
+      Tracer::begin(TraceCategory::task, name.c_str());
+      {
+        RealtimeCheck::Context context(name.c_str(), realtime);
+        task.run();
+      }
+      Tracer::end(TraceCategory::task, name.c_str());
+      counter.tock();
+      busy.store(false, std::memory_order_release);
+      uint64_t missed = misses.exchange(0, std::memory_order_acquire);
+      if (missed > 0) {
+        uint64_t t = missTime.exchange(0, std::memory_order_relaxed);
+        counter.overrun(missed, (t > 0) ? (now() - t) * 1e-9 : 0);
+      }
+      wakeup.wait();
+    }
   }
 
-  semaphore.wait();
-  while (!finished) {
+  stackHighWater = Executor::get_stack_high_water();
+  EEROS_LOG_TRACE(log) << "stopping thread " << pid << ":" << tid;
+}
+
+void Async::run_timed() {
+  CycleTimer timer(period);
+  timer.start();
+  while (true) {
+    timer.sleep();
+    if (finished) break;
     counter.tick();
-    task.run();
+    Tracer::begin(TraceCategory::task, name.c_str());
+    {
+      RealtimeCheck::Context context(name.c_str(), realtime);
+      task.run();
+    }
+    Tracer::end(TraceCategory::task, name.c_str());
     counter.tock();
-    semaphore.wait();
+    uint64_t missed = timer.next();
+    if (missed > 0) {
+      Tracer::instant(TraceCategory::task, "deadline miss", missed);
+      counter.overrun(missed, timer.getLateness() * 1e-9);
+      if (overrunPolicy == OverrunPolicy::coalesce) timer.skip(missed - 1);
+      else if (overrunPolicy != OverrunPolicy::catchUp) timer.skip(missed);
+      if (overrunPolicy == OverrunPolicy::triggerEvent) safetySystem->triggerEvent(*overrunEvent);
+    }
   }
-
-  log.trace() << "stopping thread " << pid << ":" << tid;
 }
@@ -3,16 +3,35 @@
 using namespace eeros::task;
 
 
-Harmonic::Harmonic(Runnable &task, int n) :
-	n(n), k(0), task(&task) { }
+Harmonic::Harmonic(Runnable &task, int n, int phase) :
+	n(n), k(0), phase(0), task(&task) {
+	setPhase(phase);
+}
 
-Harmonic::Harmonic(Runnable *task, int n) :
-	n(n), k(0), task(task) { }
+Harmonic::Harmonic(Runnable *task, int n, int phase) :
+	n(n), k(0), phase(0), task(task) {
+	setPhase(phase);
+}
 
 eeros::Runnable * Harmonic::getTask() {
 	return task;
 }
 
+int Harmonic::getN() const {
+	return n;
+}
+
+int Harmonic::getPhase() const {
+	return phase;
+}
+
+void Harmonic::setPhase(int phase) {
+	if (n <= 1) return;
+	phase = ((phase % n) + n) % n;
+	k = (((k - (phase - this->phase)) % n) + n) % n;
+	this->phase = phase;
+}
+
 void Harmonic::run() {
 	if (++k >= n) {
 		task->run();
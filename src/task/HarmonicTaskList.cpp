@@ -1,17 +1,86 @@
 #include <eeros/task/HarmonicTaskList.hpp>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace eeros::task;
 
+constexpr std::size_t HarmonicTaskList::maxHyperperiod;
+
+namespace {
+	std::size_t gcd(std::size_t a, std::size_t b) {
+		while (b != 0) {
+			std::size_t t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+
+	// index of the first call of run() in a hyperperiod on which a task runs
+	std::size_t offset(const Harmonic &t) {
+		return (t.getN() <= 1) ? 0 : (t.getN() - 1 + t.getPhase()) % t.getN();
+	}
+}
 
 void HarmonicTaskList::run() {
 	for (auto &t: tasks)
 		t.run();
 }
 
-void HarmonicTaskList::add(Runnable *t, int n) {
-	tasks.push_back(Harmonic(t, n));
+void HarmonicTaskList::add(Runnable *t, int n, int phase) {
+	tasks.push_back(Harmonic(t, n, phase));
+}
+
+void HarmonicTaskList::add(Runnable &t, int n, int phase) {
+	tasks.push_back(Harmonic(t, n, phase));
+}
+
+std::size_t HarmonicTaskList::getHyperperiod() const {
+	std::size_t h = 1;
+	for (auto &t: tasks) {
+		std::size_t n = std::max(t.getN(), 1);
+		h = h / gcd(h, n) * n;
+		if (h > maxHyperperiod) return maxHyperperiod;
+	}
+	return h;
+}
+
+void HarmonicTaskList::addLoad(std::size_t i, double runTime) {
+	std::size_t n = std::max(tasks[i].getN(), 1);
+	for (std::size_t c = offset(tasks[i]); c < load.size(); c += n) load[c] += runTime;
+}
+
+void HarmonicTaskList::stagger(const std::vector<double> &runTimes, const std::vector<bool> &fixed) {
+	if (runTimes.size() != tasks.size()) throw std::invalid_argument("number of run times does not match number of tasks");
+	load.assign(getHyperperiod(), 0.0);
+	order.clear();
+	for (std::size_t i = 0; i < tasks.size(); i++) {
+		if (tasks[i].getN() <= 1 || (i < fixed.size() && fixed[i])) addLoad(i, runTimes[i]);
+		else order.push_back(i);
+	}
+	std::sort(order.begin(), order.end(), [&runTimes] (std::size_t a, std::size_t b) {
+		return (runTimes[a] != runTimes[b]) ? runTimes[a] > runTimes[b] : a < b;
+	});
+	for (auto i: order) {
+		int n = tasks[i].getN();
+		int best = 0;
+		double bestPeak = 0;
+		for (int p = 0; p < n; p++) {
+			double peak = 0;
+			for (std::size_t c = (n - 1 + p) % n; c < load.size(); c += n) peak = std::max(peak, load[c]);
+			if (p == 0 || peak < bestPeak) {
+				best = p;
+				bestPeak = peak;
+			}
+		}
+		tasks[i].setPhase(best);
+		addLoad(i, runTimes[i]);
+	}
 }
 
-void HarmonicTaskList::add(Runnable &t, int n) {
-	tasks.push_back(Harmonic(t, n));
+double HarmonicTaskList::getPeakLoad(const std::vector<double> &runTimes) {
+	if (runTimes.size() != tasks.size()) throw std::invalid_argument("number of run times does not match number of tasks");
+	load.assign(getHyperperiod(), 0.0);
+	for (std::size_t i = 0; i < tasks.size(); i++) addLoad(i, runTimes[i]);
+	return *std::max_element(load.begin(), load.end());
 }
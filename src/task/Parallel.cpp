@@ -0,0 +1,140 @@
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <eeros/task/Parallel.hpp>
+#include <eeros/core/CycleTime.hpp>
+#include <eeros/core/Executor.hpp>
+#include <eeros/core/RealtimeCheck.hpp>
+#include <eeros/core/Tracer.hpp>
+
+using namespace eeros::task;
+using namespace eeros::logger;
+
+namespace {
+inline void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+}
+
+Parallel::Parallel(std::vector<TaskList> partitions, std::vector<int> cpus, unsigned spinCount)
+    : spinCount(spinCount), generation(0), pending(0), sleepers(0), finished(false), cycleTime(CycleTime::unset),
+      schedulingSet(false), policy(SCHED_OTHER), log(Logger::getLogger('A')) {
+  if (partitions.empty()) return;
+  first = partitions[0];
+  for (std::size_t i = 1; i < partitions.size(); i++) {
+    workers.emplace_back(new Worker());
+    workers.back()->tasks = partitions[i];
+    workers.back()->cpu = (i - 1 < cpus.size()) ? cpus[i - 1] : -1;
+  }
+  for (auto &w : workers) w->thread = std::thread(&Parallel::run_worker, this, std::ref(*w));
+}
+
+Parallel::~Parallel() {
+  finished = true;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    cv.notify_all();
+  }
+  for (auto &w : workers) {
+    if (w->thread.joinable()) w->thread.join();
+  }
+}
+
+std::size_t Parallel::getNofPartitions() const {
+  return workers.size() + 1;
+}
+
+void Parallel::run() {
+  if (!schedulingSet) {
+    pthread_getschedparam(pthread_self(), &policy, &schedulingParam);
+    schedulingSet = true;
+  }
+  if (!workers.empty()) {
+    pending.store(workers.size(), std::memory_order_relaxed);
+    cycleTime = CycleTime::get();
+    generation.fetch_add(1);
+    if (sleepers.load() > 0) {
+      std::lock_guard<std::mutex> lock(mtx);
+      cv.notify_all();
+    }
+  }
+
+  std::exception_ptr error;
+  try {
+    first.run();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  // join, yield after spinning for a while to let workers sharing this core run
+  unsigned spin = 0;
+  while (pending.load(std::memory_order_acquire) != 0) {
+    if (++spin < spinCount) relax();
+    else std::this_thread::yield();
+  }
+
+  for (auto &w : workers) {
+    if (w->error) {
+      if (!error) error = w->error;
+      w->error = nullptr;
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+void Parallel::run_worker(Worker& worker) {
+  const auto pid = getpid();
+  const auto tid = syscall(SYS_gettid);
+
+  Executor::prefault_stack();
+  Tracer::registerThread("parallel worker");
+
+  if (worker.cpu >= 0) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(worker.cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+      log.error() << "could not pin worker thread " << pid << ":" << tid << " to cpu " << worker.cpu;
+  }
+  log.trace() << "starting worker thread " << pid << ":" << tid << " on cpu " << worker.cpu;
+
+  uint64_t last = 0;
+  bool schedulingApplied = false;
+  while (true) {
+    uint64_t current;
+    unsigned spin = 0;
+    while ((current = generation.load(std::memory_order_acquire)) == last && !finished) {
+      if (++spin < spinCount) {
+        relax();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mtx);
+      sleepers++;
+      cv.wait(lock, [&] { return generation.load() != last || finished; });
+      sleepers--;
+    }
+    if (finished) break;
+    last = current;
+
+    if (!schedulingApplied) {
+      if (pthread_setschedparam(pthread_self(), policy, &schedulingParam) != 0)
+        log.error() << "could not set priority of worker thread " << pid << ":" << tid;
+      schedulingApplied = true;
+    }
+
+    try {
+      Tracer::Scope scope(TraceCategory::timeDomain, "partition");
+      RealtimeCheck::Context context("parallel worker", policy != SCHED_OTHER);
+      CycleTime::Scope cycle(cycleTime);
+      worker.tasks.run();
+    } catch (...) {
+      worker.error = std::current_exception();
+    }
+    pending.fetch_sub(1, std::memory_order_release);
+  }
+
+  log.trace() << "stopping worker thread " << pid << ":" << tid;
+}
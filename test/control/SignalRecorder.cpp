@@ -0,0 +1,135 @@
+#include <eeros/control/SignalRecorder.hpp>
+#include <eeros/control/PeripheralInput.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Block1o.hpp>
+#include <eeros/hal/HAL.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::control;
+
+namespace {
+// input of the HAL delivering a sine with a timestamp counting up
+class SineInput : public hal::Input<double> {
+ public:
+  SineInput(std::string id) : hal::Input<double>(id, nullptr), n(0) { }
+  virtual double get() { return std::sin(0.1 * ++n); }
+  virtual uint64_t getTimestamp() { return 1000 * n; }
+  int n;
+};
+
+class Counter : public Block1o<int> {
+ public:
+  Counter() : n(0) { }
+  virtual void run() {
+    this->out.getSignal().setValue(n++);
+    this->out.getSignal().setTimestamp(n);
+  }
+  int n;
+};
+
+std::string fileName(std::string name) {
+  return ::testing::TempDir() + "controlSignalRecorderTest_" + name;
+}
+}
+
+// The recorder runs after the blocks it records, whatever the order in which they were added
+TEST(controlSignalRecorderTest, record) {
+  hal::HAL::instance().addInput(new SineInput("recordSine"));
+  TimeDomain td("td", 0.001, false);
+  SignalRecorder recorder;
+  PeripheralInput<double> sine("recordSine");
+  Counter counter;
+  td.addBlock(recorder);
+  td.addBlock(sine);
+  td.addBlock(counter);
+  recorder.addPeripheralInputs(td);
+  recorder.add(counter.getOut(), "counter");
+  ASSERT_EQ(recorder.getChannels().size(), 2u);
+  EXPECT_EQ(recorder.getChannels()[0].name, "recordSine");
+  EXPECT_TRUE(recorder.getChannels()[0].peripheral);
+  EXPECT_EQ(recorder.getChannels()[0].type, RecordType::float64);
+  EXPECT_EQ(recorder.getChannels()[1].type, RecordType::int32);
+  td.compile();
+
+  recorder.start(fileName("record"));
+  for (int i = 0; i < 100; i++) td.run();
+  recorder.stop();
+  EXPECT_EQ(recorder.getNofRecords(), 100u);
+  EXPECT_EQ(recorder.getOverflows(), 0u);
+
+  SignalReplay replay(fileName("record"));
+  EXPECT_EQ(replay.getNofRecords(), 100u);
+  EXPECT_EQ(replay.getMissingRecords(), 0u);
+  ASSERT_EQ(replay.getChannels().size(), 2u);
+  EXPECT_EQ(replay.getChannels()[1].name, "counter");
+  EXPECT_FALSE(replay.getChannels()[1].peripheral);
+  auto counts = replay.install<int>("counter");
+  for (int i = 0; i < 100; i++) EXPECT_EQ(counts->get(), i);
+  std::remove(fileName("record").c_str());
+}
+
+// Records which do not fit into the buffer are dropped and counted
+TEST(controlSignalRecorderTest, overflow) {
+  SignalRecorder recorder(4);
+  Counter counter;
+  recorder.add(counter.getOut(), "counter");
+  recorder.start(fileName("overflow"));
+  for (int i = 0; i < 1000; i++) {
+    counter.run();
+    recorder.run();
+  }
+  EXPECT_THROW(recorder.add(counter.getOut(), "late"), Fault);
+  recorder.stop();
+  EXPECT_EQ(recorder.getNofRecords() + recorder.getOverflows(), 1000u);
+  std::remove(fileName("overflow").c_str());
+}
+
+// A time domain fed by the replay computes the recorded outputs bit for bit
+TEST(controlSignalRecorderTest, replay) {
+  hal::HAL::instance().addInput(new SineInput("replaySine"));
+  std::vector<double> outputs;
+  {
+    TimeDomain td("td", 0.001, false);
+    SignalRecorder recorder;
+    PeripheralInput<double> sine("replaySine");
+    Gain<> gain(3.7);
+    gain.getIn().connect(sine.getOut());
+    td.addBlock(sine);
+    td.addBlock(gain);
+    td.addBlock(recorder);
+    recorder.add(sine.getOut(), "replayedSine");
+    recorder.start(fileName("replay"));
+    for (int i = 0; i < 50; i++) {
+      td.run();
+      outputs.push_back(gain.getOut().getSignal().getValue());
+    }
+    recorder.stop();
+  }
+
+  SignalReplay replay(fileName("replay"));
+  replay.install<double>("replayedSine");
+  EXPECT_THROW(replay.install<float>("replayedSine"), Fault);
+  EXPECT_THROW(replay.install<double>("unknown"), Fault);
+  TimeDomain td("td", 0.001, false);
+  PeripheralInput<double> sine("replayedSine");
+  Gain<> gain(3.7);
+  gain.getIn().connect(sine.getOut());
+  td.addBlock(sine);
+  td.addBlock(gain);
+  for (int i = 0; i < 50; i++) {
+    EXPECT_FALSE(replay.isFinished());
+    td.run();
+    EXPECT_EQ(gain.getOut().getSignal().getValue(), outputs[i]);
+    EXPECT_EQ(sine.getOut().getSignal().getTimestamp(), 1000u * (i + 1));
+  }
+  EXPECT_TRUE(replay.isFinished());
+  td.run();
+  EXPECT_EQ(gain.getOut().getSignal().getValue(), outputs.back());
+  std::remove(fileName("replay").c_str());
+}
@@ -0,0 +1,299 @@
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Block1i1o.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Delay.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/core/CycleTime.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+
+namespace {
+class Recorder : public Block1i1o<> {
+ public:
+  Recorder(std::string name, std::vector<std::string>& order) : order(order) { this->setName(name); }
+  virtual void run() {
+    order.push_back(this->getName());
+    this->out.getSignal().setValue(this->in.getSignal().getValue() + 1);
+    this->out.getSignal().setTimestamp(this->in.getSignal().getTimestamp());
+  }
+  std::vector<std::string>& order;
+};
+
+template < typename B >
+class Recorded : public B {
+ public:
+  template < typename... A >
+  Recorded(std::string name, std::vector<std::string>& order, A... args) : B(args...), order(order) { this->setName(name); }
+  virtual void run() {
+    order.push_back(this->getName());
+    B::run();
+  }
+  std::vector<std::string>& order;
+};
+
+class Doubler : public Block1i1o<> {
+ public:
+  virtual void run() {
+    thread = std::this_thread::get_id();
+    this->out.getSignal().setValue(this->in.getSignal().getValue() * 2);
+    this->out.getSignal().setTimestamp(this->in.getSignal().getTimestamp());
+  }
+  std::thread::id thread;
+};
+
+class Sleeper : public Block1i1o<> {
+ public:
+  Sleeper(std::string name, int us) : us(us) { this->setName(name); }
+  virtual void run() {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+    this->out.getSignal().setValue(this->in.getSignal().getValue());
+  }
+  int us;
+};
+}
+
+// Blocks added in reverse order are run in the order of their data dependencies
+TEST(controlTimeDomainTest, sortChain) {
+  std::vector<std::string> order;
+  Constant<> c(1.0);
+  c.setName("c");
+  Recorder r1("r1", order), r2("r2", order), r3("r3", order);
+  r1.getIn().connect(c.getOut());
+  r2.getIn().connect(r1.getOut());
+  r3.getIn().connect(r2.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(r3);
+  td.addBlock(r2);
+  td.addBlock(r1);
+  td.addBlock(c);
+  EXPECT_FALSE(td.isCompiled());
+  EXPECT_TRUE(td.compile());
+  EXPECT_TRUE(td.isCompiled());
+  td.run();
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order[0], "r1");
+  EXPECT_EQ(order[1], "r2");
+  EXPECT_EQ(order[2], "r3");
+  EXPECT_EQ(r3.getOut().getSignal().getValue(), 4.0);
+}
+
+// Independent blocks keep the order in which they were added
+TEST(controlTimeDomainTest, keepInsertionOrder) {
+  std::vector<std::string> order;
+  Constant<> c(0.0);
+  Recorder a1("a1", order), a2("a2", order), b1("b1", order), b2("b2", order);
+  a1.getIn().connect(c.getOut());
+  b1.getIn().connect(c.getOut());
+  a2.getIn().connect(a1.getOut());
+  b2.getIn().connect(b1.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(c);
+  td.addBlock(b2);
+  td.addBlock(a1);
+  td.addBlock(b1);
+  td.addBlock(a2);
+  EXPECT_TRUE(td.compile());
+  td.run();
+  ASSERT_EQ(order.size(), 4);
+  EXPECT_EQ(order[0], "a1");
+  EXPECT_EQ(order[1], "b1");
+  EXPECT_EQ(order[2], "b2");
+  EXPECT_EQ(order[3], "a2");
+}
+
+// An algebraic loop is reported and its blocks keep the order in which they were added
+TEST(controlTimeDomainTest, algebraicLoop) {
+  std::vector<std::string> order;
+  Constant<> c(1.0);
+  Sum<> s;
+  s.setName("s");
+  Recorder r1("r1", order), r2("r2", order), r3("r3", order);
+  s.getIn(0).connect(c.getOut());
+  s.getIn(1).connect(r2.getOut());
+  s.setInitCondition(1, 0.0);
+  r1.getIn().connect(s.getOut());
+  r2.getIn().connect(r1.getOut());
+  r3.getIn().connect(r2.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(r3);
+  td.addBlock(c);
+  td.addBlock(s);
+  td.addBlock(r2);
+  td.addBlock(r1);
+  EXPECT_FALSE(td.compile());
+  td.run();
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order[0], "r2");
+  EXPECT_EQ(order[1], "r1");
+  EXPECT_EQ(order[2], "r3");
+}
+
+// A feedback loop through a delay is no algebraic loop, the delay runs ahead of the loop
+TEST(controlTimeDomainTest, delayInLoop) {
+  std::vector<std::string> order;
+  Constant<> c(1.0);
+  Recorded<Sum<>> s("s", order);
+  Recorded<Gain<>> g("g", order, 0.5);
+  Recorded<Delay<>> d("d", order, 0.002, 0.001);
+  s.getIn(0).connect(c.getOut());
+  s.getIn(1).connect(d.getOut());
+  g.getIn().connect(s.getOut());
+  d.getIn().connect(g.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(g);
+  td.addBlock(s);
+  td.addBlock(d);
+  td.addBlock(c);
+  EXPECT_TRUE(td.compile());
+  td.run();
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order[0], "d");
+  EXPECT_EQ(order[1], "s");
+  EXPECT_EQ(order[2], "g");
+  
+  // a delay of a single period passes its input on within the same cycle
+  Recorded<Delay<>> d1("d1", order, 0.001, 0.001);
+  s.getIn(1).disconnect();
+  s.getIn(1).connect(d1.getOut());
+  d1.getIn().connect(g.getOut());
+  td.removeBlock(d);
+  td.addBlock(d1);
+  EXPECT_FALSE(td.compile());
+}
+
+// Adding a block discards the schedule
+TEST(controlTimeDomainTest, addBlockAfterCompile) {
+  std::vector<std::string> order;
+  Constant<> c(1.0);
+  Recorder r1("r1", order), r2("r2", order);
+  r1.getIn().connect(c.getOut());
+  r2.getIn().connect(r1.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(c);
+  td.addBlock(r2);
+  EXPECT_TRUE(td.compile());
+  td.addBlock(r1);
+  EXPECT_FALSE(td.isCompiled());
+  td.run();
+  ASSERT_EQ(order.size(), 2);
+  EXPECT_EQ(order[0], "r2");
+  EXPECT_EQ(order[1], "r1");
+}
+
+// Independent subgraphs run on different threads and deliver the same outputs as serial execution
+TEST(controlTimeDomainTest, parallel) {
+  Constant<> c1(1.0), c2(3.0);
+  Doubler a1, a2, b1, b2;
+  a1.getIn().connect(c1.getOut());
+  a2.getIn().connect(a1.getOut());
+  b1.getIn().connect(c2.getOut());
+  b2.getIn().connect(b1.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(a2);
+  td.addBlock(b2);
+  td.addBlock(a1);
+  td.addBlock(b1);
+  td.addBlock(c1);
+  td.addBlock(c2);
+  td.setParallel(2);
+  EXPECT_TRUE(td.compile());
+  EXPECT_EQ(td.getNofPartitions(), 2);
+  for (int i = 0; i < 100; i++) td.run();
+  EXPECT_EQ(a2.getOut().getSignal().getValue(), 4.0);
+  EXPECT_EQ(b2.getOut().getSignal().getValue(), 12.0);
+  EXPECT_EQ(a1.thread, a2.thread);
+  EXPECT_EQ(b1.thread, b2.thread);
+  EXPECT_NE(a1.thread, b1.thread);
+  
+  td.setParallel(1);
+  EXPECT_TRUE(td.compile());
+  EXPECT_EQ(td.getNofPartitions(), 1);
+}
+
+// A fault in a worker partition is reported by the thread running the time domain
+TEST(controlTimeDomainTest, parallelFault) {
+  Constant<> c(1.0);
+  Doubler a, b;
+  b.setName("b");
+  a.getIn().connect(c.getOut());
+  TimeDomain td("td", 0.001, false);
+  td.addBlock(c);
+  td.addBlock(a);
+  td.addBlock(b);
+  td.setParallel(2);
+  td.compile();
+  EXPECT_EQ(td.getNofPartitions(), 2);
+  try {
+    td.run();
+    FAIL();
+  } catch (eeros::Fault const & err) {
+    EXPECT_EQ(err.what(), std::string("Read from an unconnected input in block 'b', time domain cannot trigger safety event"));
+  }
+}
+
+// The profiler measures every block and reports the most expensive block first
+TEST(controlTimeDomainTest, profiling) {
+  Constant<> c(1.0);
+  c.setName("c");
+  Sleeper fast("fast", 100), slow("slow", 2000);
+  fast.getIn().connect(c.getOut());
+  slow.getIn().connect(fast.getOut());
+  TimeDomain td("td", 0.01, false);
+  td.addBlock(c);
+  td.addBlock(fast);
+  td.addBlock(slow);
+  td.compile();
+  td.run();
+  EXPECT_TRUE(td.getProfile().empty());
+
+  td.setProfiling(true);
+  EXPECT_FALSE(td.isCompiled());
+  td.compile();
+  for (int i = 0; i < 5; i++) td.run();
+  EXPECT_EQ(slow.getOut().getSignal().getValue(), 1.0);
+  auto profile = td.getProfile();
+  ASSERT_EQ(profile.size(), 3);
+  EXPECT_EQ(profile[0].name, "slow");
+  EXPECT_EQ(profile[1].name, "fast");
+  EXPECT_EQ(profile[2].name, "c");
+  for (auto& b : profile) {
+    EXPECT_EQ(b.count, 5);
+    EXPECT_LE(b.min, b.mean);
+    EXPECT_LE(b.mean, b.max);
+  }
+  EXPECT_GE(profile[0].min, 0.002);
+  EXPECT_GE(profile[1].min, 0.0001);
+  td.logProfile(2);
+
+  td.resetProfile();
+  EXPECT_EQ(td.getProfile()[0].count, 0);
+}
+
+
+// All blocks of a cycle stamp their outputs with the time at which the cycle started
+TEST(controlTimeDomainTest, cycleTime) {
+  Constant<> c1(1.0), c2(2.0);
+  Sleeper sleeper("sleeper", 1000);
+  sleeper.getIn().connect(c1.getOut());
+  TimeDomain td("td", 0.01, false);
+  td.addBlock(c1);
+  td.addBlock(sleeper);
+  td.addBlock(c2);
+  EXPECT_TRUE(td.getCycleTime());
+  auto before = System::getTimeNs();
+  td.run();
+  EXPECT_GE(c1.getOut().getSignal().getTimestamp(), before);
+  EXPECT_EQ(c1.getOut().getSignal().getTimestamp(), c2.getOut().getSignal().getTimestamp());
+  EXPECT_EQ(CycleTime::get(), CycleTime::unset);
+
+  td.setCycleTime(false);
+  td.run();
+  EXPECT_GE(c2.getOut().getSignal().getTimestamp(), c1.getOut().getSignal().getTimestamp() + 1000000);
+}
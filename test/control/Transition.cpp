@@ -3,6 +3,11 @@
 #include <eeros/core/Fault.hpp>
 #include <eeros/control/Transition.hpp>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
 #include <Utils.hpp>
 
 using namespace eeros;
@@ -128,3 +133,190 @@ TEST(controlTransitionSimpleTest, steady) {
 	EXPECT_TRUE(Utils::compareApprox(t2.outBlock.getOut().getSignal().getValue(), 1.0, 1e-10));
 }
 
+namespace {
+	using Vector8 = Matrix<8,1>;
+
+	void setSample(Output<Vector8>& out, uint64_t k, timestamp_t time) {
+		Vector8 v;
+		v.fill(k);
+		out.getSignal().setValue(v);
+		out.getSignal().setTimestamp(time);
+	}
+
+	bool isTorn(const Vector8& v) {
+		for (unsigned i = 1; i < 8; i++) if (v[i] != v[0]) return true;
+		return false;
+	}
+
+	// runs f every period until it returns false
+	template < typename F >
+	void runPeriodic(std::chrono::microseconds period, F f) {
+		auto next = std::chrono::steady_clock::now();
+		while (f()) {
+			next += period;
+			std::this_thread::sleep_until(next);
+		}
+	}
+}
+
+TEST(controlTransitionQueueTest, noLoss) {
+	TransitionQueue<uint64_t> q(8);
+	EXPECT_EQ(q.capacity(), 8);
+	const uint64_t n = 1000000;
+	std::thread producer([&] {
+		for (uint64_t i = 0; i < n; i++) {
+			while (!q.push(i)) std::this_thread::yield();
+		}
+	});
+	uint64_t expected = 0, v;
+	while (expected < n) {
+		if (q.pop(v)) EXPECT_EQ(v, expected++);
+		else std::this_thread::yield();
+	}
+	producer.join();
+	EXPECT_FALSE(q.pop(v));
+}
+
+// a producer which never waits and a slow consumer, every sample is either received or counted as overflow
+TEST(controlTransitionQueueTest, overflow) {
+	TransitionQueue<Vector8> q(8);
+	const uint64_t n = 200000;
+	std::atomic<bool> done(false);
+	std::thread producer([&] {
+		Vector8 v;
+		for (uint64_t i = 1; i <= n; i++) {
+			v.fill(i);
+			q.push(v);
+		}
+		done = true;
+	});
+	uint64_t received = 0, last = 0;
+	unsigned torn = 0, reordered = 0;
+	Vector8 v;
+	auto drain = [&] {
+		while (q.pop(v)) {
+			received++;
+			if (isTorn(v)) torn++;
+			if (v[0] <= last) reordered++;
+			last = v[0];
+		}
+	};
+	while (!done) {
+		drain();
+		std::this_thread::sleep_for(std::chrono::microseconds(10));
+	}
+	producer.join();
+	drain();
+	EXPECT_EQ(torn, 0);
+	EXPECT_EQ(reordered, 0);
+	EXPECT_EQ(received + q.getOverflows(), n);
+}
+
+TEST(controlTransitionStressTest, down) {
+	Transition<Vector8> t(0.1);
+	Output<Vector8> src, ref;
+	setSample(src, 0, 0);
+	setSample(ref, 0, std::numeric_limits<timestamp_t>::max());
+	t.inBlock.getIn().connect(src);
+	t.outBlock.getIn().connect(ref);
+	const uint64_t n = 5000;
+	std::atomic<bool> done(false);
+
+	std::thread fast([&] {	// 10 kHz
+		uint64_t k = 1;
+		runPeriodic(std::chrono::microseconds(100), [&] {
+			setSample(src, k, k);
+			t.inBlock.run();
+			return ++k <= n;
+		});
+		done = true;
+	});
+	timestamp_t last = 0;
+	unsigned torn = 0, backwards = 0;
+	auto check = [&] {
+		t.outBlock.run();
+		auto& sig = t.outBlock.getOut().getSignal();
+		if (std::isnan(sig.getValue()[0])) return;	// nothing received yet
+		if (isTorn(sig.getValue()) || sig.getValue()[0] != sig.getTimestamp()) torn++;
+		if (sig.getTimestamp() < last) backwards++;
+		last = sig.getTimestamp();
+	};
+	runPeriodic(std::chrono::microseconds(1000), [&] {	// 1 kHz
+		check();
+		return !done;
+	});
+	fast.join();
+	check();
+	EXPECT_EQ(torn, 0);
+	EXPECT_EQ(backwards, 0);
+	if (t.getOverflows() == 0) EXPECT_EQ(last, n);	// the last sample may have been dropped otherwise
+	else EXPECT_LE(last, n);
+}
+
+TEST(controlTransitionStressTest, up) {
+	Transition<Vector8> t(10);
+	Output<Vector8> src;
+	setSample(src, 0, 0);
+	t.inBlock.getIn().connect(src);
+	const uint64_t n = 500;
+	std::atomic<bool> done(false);
+
+	std::thread slow([&] {	// 1 kHz
+		uint64_t k = 1;
+		runPeriodic(std::chrono::microseconds(1000), [&] {
+			setSample(src, k, k * 10);
+			t.inBlock.run();
+			return ++k <= n;
+		});
+		done = true;
+	});
+	unsigned torn = 0, valid = 0;
+	runPeriodic(std::chrono::microseconds(100), [&] {	// 10 kHz
+		t.outBlock.run();
+		auto& sig = t.outBlock.getOut().getSignal();
+		if (!std::isnan(sig.getValue()[0])) {
+			valid++;
+			if (isTorn(sig.getValue()) || !Utils::compareApprox(sig.getValue()[0] * 10, sig.getTimestamp(), 1e-6)) torn++;
+		}
+		return !done;
+	});
+	slow.join();
+	EXPECT_GT(valid, 0);
+	EXPECT_EQ(torn, 0);
+}
+
+TEST(controlTransitionStressTest, steady) {
+	Transition<Vector8> t(0.1, true);
+	Output<Vector8> src;
+	setSample(src, 0, 0);
+	t.inBlock.getIn().connect(src);
+	const uint64_t n = 5000;
+	std::atomic<bool> done(false);
+
+	std::thread fast([&] {	// 10 kHz
+		uint64_t k = 1;
+		runPeriodic(std::chrono::microseconds(100), [&] {
+			setSample(src, k, k);
+			t.inBlock.run();
+			return ++k <= n;
+		});
+		done = true;
+	});
+	timestamp_t last = 0;
+	unsigned torn = 0, backwards = 0;
+	runPeriodic(std::chrono::microseconds(1000), [&] {	// 1 kHz
+		t.outBlock.run();
+		auto& sig = t.outBlock.getOut().getSignal();
+		if (!std::isnan(sig.getValue()[0])) {
+			if (isTorn(sig.getValue()) || sig.getValue()[0] != sig.getTimestamp()) torn++;
+			if (sig.getTimestamp() < last) backwards++;
+			last = sig.getTimestamp();
+		}
+		return !done;
+	});
+	fast.join();
+	t.outBlock.run();
+	EXPECT_EQ(t.outBlock.getOut().getSignal().getTimestamp(), n);
+	EXPECT_EQ(torn, 0);
+	EXPECT_EQ(backwards, 0);
+}
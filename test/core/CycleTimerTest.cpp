@@ -0,0 +1,41 @@
+#include <eeros/core/CycleTimer.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+
+using namespace eeros;
+
+namespace {
+uint64_t now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+}
+
+// Deadlines are kept in integer nanoseconds and do not drift
+TEST(coreCycleTimerTest, deadlines) {
+  CycleTimer timer(0.001);
+  EXPECT_EQ(timer.getPeriod(), 1000000);
+  timer.start();
+  uint64_t first = timer.getDeadline();
+  for (int i = 0; i < 10; i++) {
+    timer.sleep();
+    EXPECT_GE(now(), timer.getDeadline());
+    timer.next();  // may report missed deadlines if the test thread was preempted
+    EXPECT_EQ(timer.getDeadline(), first + (i + 1) * 1000000);
+  }
+  EXPECT_EQ(timer.getDeadline(), first + 10 * 1000000);
+}
+
+// An overrun reports the number of passed deadlines which can then be skipped
+TEST(coreCycleTimerTest, overrun) {
+  CycleTimer timer(0.001);
+  timer.start();
+  timer.sleep();
+  std::this_thread::sleep_for(std::chrono::microseconds(3500));
+  uint64_t missed = timer.next();
+  EXPECT_GE(missed, 3);
+  timer.skip(missed);
+  EXPECT_GT(timer.getDeadline(), now());
+}
@@ -0,0 +1,51 @@
+#include <eeros/core/Executor.hpp>
+#include <eeros/task/Periodic.hpp>
+#include <eeros/task/Lambda.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using namespace eeros;
+
+namespace {
+// the executor is a singleton and keeps its periodics, so their tasks must outlive the tests
+task::Lambda idle;
+
+Executor& executor() {
+  Executor &e = Executor::instance();
+  if (e.getMainTask() == nullptr) e.setExecutorPeriod(0.001);
+  return e;
+}
+}
+
+// A periodic on a timer of its own is rejected in virtual time before any thread is started, 
+// including the thread dumping the counters
+TEST(coreExecutorTest, timedPeriodicInVirtualTime) {
+  Executor &e = executor();
+  e.setSchedulingMode(SchedulingMode::rateMonotonic);
+  e.setCounterDump(10);
+  e.setVirtualTime(true);
+  task::Periodic timed("timed", 0.0015, idle, false);
+  e.add(timed);
+  EXPECT_THROW(e.run(), std::runtime_error);
+  e.setVirtualTime(false);
+  e.setCounterDump(0);
+  e.setSchedulingMode(SchedulingMode::harmonic);
+}
+
+// A periodic run after another one keeps its order, so it can not run on a timer of its own
+TEST(coreExecutorTest, nestedNonHarmonicPeriodic) {
+  Executor &e = executor();
+  e.setSchedulingMode(SchedulingMode::rateMonotonic);
+  task::Periodic parent("parent", 0.002, idle, false);
+  task::Periodic child("child", 0.003, idle, false);
+  parent.after.push_back(child);
+  e.add(parent);
+  try {
+    e.run();
+    FAIL();
+  } catch (std::runtime_error const & err) {
+    EXPECT_EQ(err.what(), std::string("periodic 'child' is run before or after 'parent' but its period is not harmonic to it"));
+  }
+  e.setSchedulingMode(SchedulingMode::harmonic);
+}
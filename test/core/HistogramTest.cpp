@@ -0,0 +1,89 @@
+#include <eeros/core/Histogram.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace eeros;
+
+TEST(coreHistogramTest, buckets) {
+  for (uint64_t v = 0; v < 32; v++) EXPECT_EQ(Histogram::lowerBound(Histogram::bucket(v)), v);
+  for (uint64_t v = 32; v < (uint64_t(1) << 36); v = v * 3 / 2 + 7) {
+    std::size_t b = Histogram::bucket(v);
+    EXPECT_LE(Histogram::lowerBound(b), v);
+    EXPECT_GT(Histogram::lowerBound(b + 1), v);
+    EXPECT_LT(v - Histogram::lowerBound(b), v / 32 + 1);
+  }
+  EXPECT_EQ(Histogram::bucket(uint64_t(1) << 40), Histogram::nofBuckets - 1);
+}
+
+TEST(coreHistogramTest, percentiles) {
+  std::unique_ptr<Histogram> h(new Histogram());
+  std::unique_ptr<Histogram::Snapshot> s(new Histogram::Snapshot());
+  h->snapshot(*s);
+  EXPECT_EQ(s->count, 0);
+  EXPECT_EQ(s->percentile(50), 0);
+  for (uint64_t v = 1; v <= 100000; v++) h->add(v * 10);
+  h->snapshot(*s);
+  EXPECT_EQ(s->count, 100000);
+  EXPECT_EQ(s->min, 10);
+  EXPECT_EQ(s->max, 1000000);
+  EXPECT_NEAR(s->mean(), 500005, 1e-6);
+  EXPECT_NEAR(s->percentile(50), 500000, 500000 * 0.032);
+  EXPECT_NEAR(s->percentile(99), 990000, 990000 * 0.032);
+  EXPECT_NEAR(s->percentile(99.9), 999000, 999000 * 0.032);
+  EXPECT_EQ(s->percentile(100), 1000000);
+  h->reset();
+  h->snapshot(*s);
+  EXPECT_EQ(s->count, 0);
+}
+
+TEST(coreHistogramTest, consistentSnapshot) {
+  std::unique_ptr<PeriodicCounter> c(new PeriodicCounter(0.0001));
+  std::atomic<bool> done(false);
+  std::thread rt([&] {
+    for (int i = 0; i < 100000; i++) {
+      c->tick();
+      c->tock();
+    }
+    done = true;
+  });
+  std::unique_ptr<PeriodicCounter::Snapshot> s(new PeriodicCounter::Snapshot());
+  unsigned inconsistent = 0;
+  while (!done) {
+    c->snapshot(*s);
+    if (s->period.count != s->jitter.count || (s->run.count > 0 && s->run.count != s->period.count + 1)) inconsistent++;
+  }
+  rt.join();
+  c->snapshot(*s);
+  EXPECT_EQ(inconsistent, 0);
+  EXPECT_EQ(s->run.count, 100000);
+  std::stringstream ss;
+  c->dump(ss);
+  EXPECT_NE(ss.str().find("p99.9 = "), std::string::npos);
+}
+
+TEST(coreHistogramTest, copyCounter) {
+  std::unique_ptr<PeriodicCounter> c(new PeriodicCounter(0.0001));
+  for (int i = 0; i < 10; i++) {
+    c->tick();
+    c->tock();
+  }
+  c->overrun(2, 0.001);
+  std::unique_ptr<PeriodicCounter> copy(new PeriodicCounter(*c));
+  c->tick();
+  c->tock();
+  std::unique_ptr<PeriodicCounter::Snapshot> s(new PeriodicCounter::Snapshot());
+  copy->snapshot(*s);
+  EXPECT_EQ(s->run.count, 10);
+  EXPECT_EQ(s->period.count, 9);
+  EXPECT_EQ(copy->run.count, 10);
+  EXPECT_EQ(copy->overruns, 1);
+  EXPECT_EQ(copy->missed, 2);
+  EXPECT_EQ(copy->maxLateness, 0.001);
+  *copy = PeriodicCounter(0.0001);
+  copy->snapshot(*s);
+  EXPECT_EQ(s->run.count, 0);
+}
@@ -0,0 +1,99 @@
+#include <eeros/core/RingBuffer.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace eeros;
+
+template < typename Buffer >
+class RingBufferTest : public ::testing::Test { };
+
+// capacity given at run time
+struct RuntimeSpscRingBuffer : SpscRingBuffer<int, 0> {
+	RuntimeSpscRingBuffer() : SpscRingBuffer<int, 0>(5) { }
+};
+
+using RingBufferTypes = ::testing::Types<SpscRingBuffer<int, 5>, RuntimeSpscRingBuffer, MpscRingBuffer<int, 5>>;
+TYPED_TEST_SUITE(RingBufferTest, RingBufferTypes);
+
+TYPED_TEST(RingBufferTest, pushPop) {
+	TypeParam rb;
+	int v;
+	EXPECT_EQ(rb.size(), 5);
+	EXPECT_FALSE(rb.pop(v));
+	for (int round = 0; round < 3; round++) {	// wraps around the storage of 8 items
+		for (int i = 0; i < 5; i++) EXPECT_TRUE(rb.push(i));
+		EXPECT_FALSE(rb.push(5));
+		EXPECT_EQ(rb.length(), 5);
+		for (int i = 0; i < 5; i++) {
+			EXPECT_TRUE(rb.pop(v));
+			EXPECT_EQ(v, i);
+		}
+		EXPECT_FALSE(rb.pop(v));
+		EXPECT_EQ(rb.length(), 0);
+	}
+}
+
+TYPED_TEST(RingBufferTest, batch) {
+	TypeParam rb;
+	int in[7] = {0, 1, 2, 3, 4, 5, 6};
+	int out[7] = {};
+	EXPECT_EQ(rb.push(in, 3), 3);
+	EXPECT_EQ(rb.push(in + 3, 4), 2);
+	EXPECT_EQ(rb.push(in + 5, 2), 0);
+	EXPECT_EQ(rb.pop(out, 2), 2);
+	EXPECT_EQ(rb.push(in + 5, 2), 2);
+	EXPECT_EQ(rb.pop(out + 2, 7), 5);
+	for (int i = 0; i < 7; i++) EXPECT_EQ(out[i], i);
+	EXPECT_EQ(rb.pop(out, 7), 0);
+}
+
+TEST(SpscRingBufferTest, concurrent) {
+	SpscRingBuffer<uint64_t, 64> rb;
+	const uint64_t n = 1000000;
+	std::thread producer([&] {
+		uint64_t batch[8];
+		for (uint64_t i = 0; i < n;) {
+			std::size_t k = 0;
+			while (k < 8 && i + k < n) { batch[k] = i + k; k++; }
+			std::size_t pushed = rb.push(batch, k);
+			i += pushed;
+			if (pushed == 0) std::this_thread::yield();
+		}
+	});
+	uint64_t expected = 0, v;
+	while (expected < n) {
+		if (rb.pop(v)) ASSERT_EQ(v, expected++);
+		else std::this_thread::yield();
+	}
+	producer.join();
+	EXPECT_FALSE(rb.pop(v));
+}
+
+TEST(MpscRingBufferTest, concurrent) {
+	MpscRingBuffer<uint64_t, 64> rb;
+	const unsigned producers = 4;
+	const uint64_t n = 200000;
+	std::vector<std::thread> threads;
+	for (unsigned p = 0; p < producers; p++) {
+		threads.emplace_back([&rb, p, n] {
+			for (uint64_t i = 0; i < n; i++) {
+				while (!rb.push((static_cast<uint64_t>(p) << 32) | i)) std::this_thread::yield();
+			}
+		});
+	}
+	std::vector<uint64_t> next(producers, 0);
+	uint64_t received = 0, v;
+	while (received < producers * n) {
+		if (rb.pop(v)) {
+			unsigned p = v >> 32;
+			ASSERT_LT(p, producers);
+			ASSERT_EQ(v & 0xffffffff, next[p]++);	// in order per producer
+			received++;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	for (auto& t : threads) t.join();
+	EXPECT_FALSE(rb.pop(v));
+}
@@ -0,0 +1,124 @@
+#include <eeros/core/RealtimeCheck.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace eeros;
+
+namespace {
+uint64_t count(const std::vector<ViolationCount> &violations, Violation kind, std::string thread, std::string location) {
+  uint64_t n = 0;
+  for (auto &v : violations)
+    if (v.kind == kind && v.thread == thread && v.location == location) n += v.count;
+  return n;
+}
+
+// touches every page of fresh memory, each page causes a minor fault
+void touch(char *memory, std::size_t pages) {
+  long pageSize = sysconf(_SC_PAGESIZE);
+  for (std::size_t i = 0; i < pages; i++) memory[i * pageSize] = 1;
+}
+
+char *map(std::size_t pages) {
+  void *p = mmap(nullptr, pages * sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return static_cast<char*>(p);
+}
+}
+
+// Page faults are reported for the location in which they happen, only in realtime contexts
+TEST(coreRealtimeCheckTest, pageFaults) {
+  const std::size_t pages = 16;
+  char *memory = map(3 * pages);
+  ASSERT_NE(memory, MAP_FAILED);
+  long pageSize = sysconf(_SC_PAGESIZE);
+  RealtimeCheck::enable();
+  EXPECT_FALSE(RealtimeCheck::isRealtime());
+  touch(memory, pages);
+  {
+    RealtimeCheck::Context context("faultContext");
+    EXPECT_TRUE(RealtimeCheck::isRealtime());
+    {
+      RealtimeCheck::Location location("faultBlock");
+      touch(memory + pages * pageSize, pages);
+    }
+    touch(memory + 2 * pages * pageSize, pages);
+  }
+  EXPECT_FALSE(RealtimeCheck::isRealtime());
+  RealtimeCheck::disable();
+  auto violations = RealtimeCheck::collect();
+  EXPECT_GE(count(violations, Violation::minorFault, "faultContext", "faultBlock"), pages);
+  EXPECT_GE(count(violations, Violation::minorFault, "faultContext", ""), pages);
+  EXPECT_LT(count(violations, Violation::minorFault, "faultContext", "faultBlock"), 2 * pages);
+  munmap(memory, 3 * pages * pageSize);
+}
+
+// Nothing is reported while checking is disabled or outside of realtime contexts
+TEST(coreRealtimeCheckTest, disabled) {
+  {
+    RealtimeCheck::Context context("disabledContext");
+    EXPECT_FALSE(RealtimeCheck::isRealtime());
+    RealtimeCheck::report(Violation::allocation);
+  }
+  RealtimeCheck::enable();
+  RealtimeCheck::report(Violation::allocation);
+  {
+    RealtimeCheck::Context context("notRealtime", false);
+    RealtimeCheck::report(Violation::allocation);
+  }
+  RealtimeCheck::disable();
+  auto violations = RealtimeCheck::collect();
+  EXPECT_EQ(count(violations, Violation::allocation, "disabledContext", ""), 0u);
+  EXPECT_EQ(count(violations, Violation::allocation, "notRealtime", ""), 0u);
+}
+
+// Explicit reports of several threads are summed up by thread and location
+TEST(coreRealtimeCheckTest, report) {
+  RealtimeCheck::enable();
+  auto work = [] {
+    RealtimeCheck::Context context("reportContext");
+    RealtimeCheck::Location location("reportBlock");
+    for (int i = 0; i < 100; i++) RealtimeCheck::report(Violation::mutexWait);
+  };
+  std::thread t1(work), t2(work);
+  t1.join();
+  t2.join();
+  RealtimeCheck::disable();
+  EXPECT_EQ(count(RealtimeCheck::collect(), Violation::mutexWait, "reportContext", "reportBlock"), 200u);
+  EXPECT_EQ(count(RealtimeCheck::collect(), Violation::mutexWait, "reportContext", "reportBlock"), 200u);
+}
+
+#ifdef EEROS_RT_CHECK
+// Allocations, deallocations and waits for a mutex are detected in realtime contexts
+TEST(coreRealtimeCheckTest, interposed) {
+  std::mutex mtx;
+  std::unique_ptr<int> outside(new int(0));
+  RealtimeCheck::enable();
+  {
+    RealtimeCheck::Context context("interposedContext");
+    RealtimeCheck::Location location("interposedBlock");
+    int *volatile p = new int(1);  // volatile, so that the allocation is not elided
+    delete p;
+    mtx.lock();
+    mtx.unlock();
+  }
+  mtx.lock();
+  std::thread t([&mtx] {
+    RealtimeCheck::Context context("interposedContext");
+    RealtimeCheck::Location location("locking");
+    mtx.lock();
+    mtx.unlock();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  mtx.unlock();
+  t.join();
+  RealtimeCheck::disable();
+  auto violations = RealtimeCheck::collect();
+  EXPECT_EQ(count(violations, Violation::allocation, "interposedContext", "interposedBlock"), 1u);
+  EXPECT_EQ(count(violations, Violation::deallocation, "interposedContext", "interposedBlock"), 1u);
+  EXPECT_EQ(count(violations, Violation::mutexWait, "interposedContext", "interposedBlock"), 0u);
+  EXPECT_EQ(count(violations, Violation::mutexWait, "interposedContext", "locking"), 1u);
+}
+#endif
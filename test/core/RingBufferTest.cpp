@@ -3,6 +3,9 @@
 #include <stdlib.h>
 #include <iostream>
 #include <eeros/core/RingBuffer.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace eeros;
 using namespace std;
@@ -71,6 +74,42 @@ void len(int len, int line) {
 	std::cout << std::endl;
 }
 
+// several producers and consumers, every item has to be popped exactly once
+void concurrent() {
+	const int producers = 2, consumers = 2, count = 100000;
+	RingBuffer<int, 4> shared;
+	std::vector<std::atomic<int>> popped(producers * count);
+	for (auto& p : popped) p = 0;
+	std::atomic<int> remaining(producers * count);
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; p++) {
+		threads.emplace_back([&shared, p] () {
+			for (int k = p * count; k < (p + 1) * count; k++) while (!shared.push(k)) std::this_thread::yield();
+		});
+	}
+	for (int c = 0; c < consumers; c++) {
+		threads.emplace_back([&shared, &popped, &remaining] () {
+			int k;
+			while (remaining > 0) {
+				if (shared.pop(k)) {
+					popped[k]++;
+					remaining--;
+				}
+				else std::this_thread::yield();
+			}
+		});
+	}
+	for (auto& t : threads) t.join();
+	int wrong = 0;
+	for (auto& p : popped) if (p != 1) wrong++;
+	cout << "concurrent " << wrong << " items not popped exactly once";
+	if (wrong > 0) {
+		cout << "		<<< ERROR";
+		ERROR++;
+	}
+	std::cout << std::endl;
+}
+
 int main() {
 	
 	LEN(0);
@@ -91,6 +130,8 @@ int main() {
 	POP();	LEN(0);
 	POP_FAIL();
 	
+	concurrent();
+	
 	if(ERROR > 0) {
 		cout << "Test failed with " << ERROR << " error(s)!" << endl;
 	}
@@ -0,0 +1,42 @@
+#include <eeros/core/Schedulability.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace eeros;
+
+// Response times are found by iterating over the preemptions of higher priority threads
+TEST(coreSchedulabilityTest, responseTime) {
+  Schedulability s;
+  s.add("a", 4, 1, 3);
+  s.add("b", 6, 2, 2);
+  s.add("c", 13, 3, 1);
+  EXPECT_TRUE(s.analyse());
+  auto &t = s.getThreads();
+  ASSERT_EQ(t.size(), 3);
+  EXPECT_DOUBLE_EQ(t[0].responseTime, 1);
+  EXPECT_DOUBLE_EQ(t[1].responseTime, 3);
+  EXPECT_DOUBLE_EQ(t[2].responseTime, 10);
+  EXPECT_NEAR(s.getUtilization(), 1.0 / 4 + 2.0 / 6 + 3.0 / 13, 1e-12);
+  EXPECT_NEAR(s.getUtilizationBound(), 3 * (std::cbrt(2.0) - 1), 1e-12);
+}
+
+// A thread whose response time exceeds its period is reported
+TEST(coreSchedulabilityTest, deadlineMiss) {
+  Schedulability s;
+  s.add("a", 4, 2, 2);
+  s.add("b", 6, 3, 1);
+  EXPECT_FALSE(s.analyse());
+  EXPECT_TRUE(s.getThreads()[0].schedulable);
+  EXPECT_FALSE(s.getThreads()[1].schedulable);
+  EXPECT_TRUE(std::isinf(s.getThreads()[1].responseTime));
+}
+
+// Threads with the same priority delay each other
+TEST(coreSchedulabilityTest, samePriority) {
+  Schedulability s;
+  s.add("a", 10, 2, 1);
+  s.add("b", 10, 3, 1);
+  EXPECT_TRUE(s.analyse());
+  EXPECT_DOUBLE_EQ(s.getThreads()[0].responseTime, 5);
+  EXPECT_DOUBLE_EQ(s.getThreads()[1].responseTime, 5);
+}
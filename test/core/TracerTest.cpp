@@ -0,0 +1,94 @@
+#include <eeros/core/Tracer.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+std::string trace() {
+  std::stringstream ss;
+  Tracer::writeChromeTrace(ss);
+  return ss.str();
+}
+
+int count(const std::string &s, const std::string &part) {
+  int n = 0;
+  for (auto i = s.find(part); i != std::string::npos; i = s.find(part, i + 1)) n++;
+  return n;
+}
+}
+
+// Nothing is recorded while tracing is disabled
+TEST(coreTracerTest, disabled) {
+  Tracer::disable();
+  std::thread t([] {
+    Tracer::registerThread("tracerDisabled");
+    Tracer::instant(TraceCategory::user, "tracerDisabledEvent");
+  });
+  t.join();
+  EXPECT_FALSE(Tracer::isEnabled(TraceCategory::user));
+  EXPECT_EQ(count(trace(), "tracerDisabled"), 0);
+}
+
+// Every thread records into a buffer of its own which is named after the thread
+TEST(coreTracerTest, threads) {
+  Tracer::enable(1024, 1u << static_cast<unsigned>(TraceCategory::user));
+  EXPECT_TRUE(Tracer::isEnabled(TraceCategory::user));
+  EXPECT_FALSE(Tracer::isEnabled(TraceCategory::block));
+  std::thread a([] {
+    Tracer::registerThread("tracerThreadA");
+    Tracer::Scope scope(TraceCategory::user, "tracerSpan", 7);
+    Tracer::instant(TraceCategory::block, "tracerFiltered");
+  });
+  std::thread b([] {
+    Tracer::instant(TraceCategory::user, "tracer \"quoted\"");
+  });
+  a.join();
+  b.join();
+  std::string s = trace();
+  EXPECT_EQ(count(s, "\"args\":{\"name\":\"tracerThreadA\"}"), 1);
+  EXPECT_EQ(count(s, "\"name\":\"tracerSpan\",\"cat\":\"user\",\"ph\":\"B\""), 1);
+  EXPECT_EQ(count(s, "\"name\":\"tracerSpan\",\"cat\":\"user\",\"ph\":\"E\""), 1);
+  EXPECT_EQ(count(s, "\"args\":{\"arg\":7}"), 2);
+  EXPECT_EQ(count(s, "tracerFiltered"), 0);
+  EXPECT_EQ(count(s, "\"name\":\"tracer \\\"quoted\\\"\""), 1);
+  Tracer::disable();
+}
+
+// A full buffer overwrites its oldest events, the slot written next is left out as it may be written meanwhile
+TEST(coreTracerTest, overwrite) {
+  Tracer::enable(4);
+  std::thread t([] {
+    Tracer::registerThread("tracerOverwrite");
+    for (int i = 0; i < 10; i++) Tracer::instant(TraceCategory::user, "tracerRing", 100 + i);
+  });
+  t.join();
+  std::string s = trace();
+  EXPECT_EQ(count(s, "tracerRing"), 3);
+  for (int i = 0; i < 7; i++) EXPECT_EQ(count(s, "\"arg\":" + std::to_string(100 + i) + "}"), 0);
+  for (int i = 7; i < 10; i++) EXPECT_EQ(count(s, "\"arg\":" + std::to_string(100 + i) + "}"), 1);
+  Tracer::disable();
+}
+
+// A saved trace converts into the same Chrome trace as written directly
+TEST(coreTracerTest, saveAndConvert) {
+  Tracer::enable(64);
+  std::thread t([] {
+    Tracer::registerThread("tracerSave");
+    Tracer::begin(TraceCategory::executor, "a name which is longer than the name of an event");
+    Tracer::end(TraceCategory::executor, "a name which is longer than the name of an event");
+  });
+  t.join();
+  Tracer::disable();
+  std::string file = ::testing::TempDir() + "coreTracerTest.trace";
+  Tracer::save(file);
+  std::stringstream converted;
+  Tracer::convert(file, converted);
+  std::string s = trace();
+  EXPECT_EQ(converted.str(), s);
+  EXPECT_EQ(count(s, "\"name\":\"" + std::string("a name which is longer than the name of an event").substr(0, sizeof(TraceEvent::name) - 1) + "\""), 2);
+  std::remove(file.c_str());
+}
@@ -0,0 +1,95 @@
+#include <eeros/core/VirtualClock.hpp>
+#include <eeros/core/System.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+// gives a newly started thread the time to go to sleep on the virtual clock
+void settle() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+}
+
+// The time of the system stands still until the virtual clock is advanced
+TEST(coreVirtualClockTest, systemTime) {
+  VirtualClock::enable(5000000000);
+  EXPECT_TRUE(VirtualClock::isEnabled());
+  EXPECT_EQ(System::getTimeNs(), 5000000000u);
+  EXPECT_DOUBLE_EQ(System::getTime(), 5.0);
+  VirtualClock::advance(1000);
+  EXPECT_EQ(System::getTimeNs(), 5000001000u);
+  VirtualClock::disable();
+  EXPECT_FALSE(VirtualClock::isEnabled());
+  EXPECT_NE(System::getTimeNs(), 5000001000u);
+}
+
+// A thread woken by advance() has finished its work before advance() returns
+TEST(coreVirtualClockTest, lockstep) {
+  VirtualClock::enable();
+  std::atomic<int> ticks(0);
+  std::atomic<uint64_t> wrongTime(0);
+  std::thread sleeper([&] {
+    for (int i = 1; i <= 5; i++) {
+      VirtualClock::sleep(0.01);
+      if (VirtualClock::now() != i * 10000000u) wrongTime++;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));  // work which takes real time
+      ticks++;
+    }
+  });
+  settle();
+  for (int k = 1; k <= 60; k++) {
+    VirtualClock::advance(1000000);
+    EXPECT_EQ(ticks, std::min(k / 10, 5)) << "after " << k << " ms";
+  }
+  sleeper.join();
+  EXPECT_EQ(wrongTime, 0u);
+  VirtualClock::disable();
+}
+
+// advance() does not wait for a thread which waits for another thread
+TEST(coreVirtualClockTest, blocking) {
+  VirtualClock::enable();
+  VirtualClock::setTimeout(10);
+  std::atomic<bool> woken(false), release(false);
+  std::thread sleeper([&] {
+    VirtualClock::sleep(0.001);
+    woken = true;
+    VirtualClock::Blocking blocking;
+    while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+  settle();
+  auto start = std::chrono::steady_clock::now();
+  VirtualClock::advance(1000000);
+  EXPECT_TRUE(woken);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  release = true;
+  sleeper.join();
+  VirtualClock::setTimeout(1);
+  VirtualClock::disable();
+}
+
+// advance() waits for a thread blocking elsewhere only until the timeout
+TEST(coreVirtualClockTest, timeout) {
+  VirtualClock::enable();
+  VirtualClock::setTimeout(0.05);
+  std::atomic<bool> release(false);
+  std::thread sleeper([&] {
+    VirtualClock::sleep(0.001);
+    while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+  settle();
+  auto start = std::chrono::steady_clock::now();
+  VirtualClock::advance(1000000);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+  start = std::chrono::steady_clock::now();
+  VirtualClock::advance(1000000);  // not waited for again
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+  release = true;
+  sleeper.join();
+  VirtualClock::setTimeout(1);
+  VirtualClock::disable();
+}
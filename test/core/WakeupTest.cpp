@@ -0,0 +1,55 @@
+#include <eeros/core/Wakeup.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace eeros;
+
+// Every post allows exactly one wait to pass
+TEST(coreWakeupTest, counting) {
+  Wakeup w;
+  EXPECT_FALSE(w.tryWait());
+  w.post();
+  w.post();
+  EXPECT_TRUE(w.tryWait());
+  w.wait();
+  EXPECT_FALSE(w.tryWait());
+}
+
+// No post is lost between a thread which posts and a thread which sleeps
+TEST(coreWakeupTest, handoff) {
+  for (unsigned spin : {0u, 1000u}) {
+    Wakeup request(spin), reply(spin);
+    std::atomic<int> received(0);
+    const int n = 20000;
+    std::thread worker([&] {
+      for (int i = 0; i < n; i++) {
+        request.wait();
+        received++;
+        reply.post();
+      }
+    });
+    for (int i = 0; i < n; i++) {
+      request.post();
+      reply.wait();
+    }
+    worker.join();
+    EXPECT_EQ(received, n);
+    EXPECT_FALSE(request.tryWait());
+  }
+}
+
+// Posts which arrive while nobody waits are kept
+TEST(coreWakeupTest, burst) {
+  Wakeup w;
+  std::atomic<int> received(0);
+  std::thread worker([&] {
+    for (int i = 0; i < 1000; i++) {
+      w.wait();
+      received++;
+    }
+  });
+  for (int i = 0; i < 1000; i++) w.post();
+  worker.join();
+  EXPECT_EQ(received, 1000);
+}
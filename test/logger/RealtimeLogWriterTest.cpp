@@ -0,0 +1,75 @@
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace eeros::logger;
+
+namespace {
+	// receives the log messages of later tests after the default logger was replaced
+	std::ostringstream& sink() {
+		static std::ostringstream s;
+		return s;
+	}
+
+	std::size_t count(const std::string& s, const std::string& pattern) {
+		std::size_t n = 0;
+		for (auto pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + 1)) n++;
+		return n;
+	}
+}
+
+TEST(RealtimeLogWriterTest, format) {
+	std::ostringstream out;
+	{
+		Logger::setDefaultRealtimeLogger(out);
+		Logger log = Logger::getLogger('R');
+		log.info() << "value " << 42 << endl << "next line";
+		log.trace() << "invisible";
+		log.warn() << std::string(2 * LogRecord::textSize, '#');
+		EXPECT_EQ(log.getDropped(), 0);
+		Logger::setDefaultRealtimeLogger(sink());
+	}	// last reference to the writer is gone, all queued messages are written
+	std::string s = out.str();
+	EXPECT_NE(s.find("R \033[22;36mI:  value 42\n\t\t\t       next line"), std::string::npos);
+	EXPECT_EQ(s.find("invisible"), std::string::npos);
+	EXPECT_EQ(count(s, "#"), static_cast<std::size_t>(LogRecord::textSize));
+}
+
+TEST(RealtimeLogWriterTest, dropped) {
+	std::ostringstream out;
+	const uint64_t n = 5000;
+	uint64_t dropped;
+	{
+		Logger::setDefaultRealtimeLogger(out);
+		Logger log = Logger::getLogger('R');
+		for (uint64_t i = 0; i < n; i++) log.info() << "message " << i;
+		dropped = log.getDropped();
+		Logger::setDefaultRealtimeLogger(sink());
+	}
+	std::string s = out.str();
+	EXPECT_GT(dropped, 0);
+	EXPECT_EQ(count(s, "message "), n - dropped);
+	EXPECT_NE(s.find("log messages dropped"), std::string::npos);
+}
+
+// numbers are formatted by the writer thread with the flags of the logging thread
+TEST(RealtimeLogWriterTest, rawValues) {
+	std::ostringstream out, expected;
+	auto message = [] (auto&& os) {
+		os << "values " << 42 << ' ' << -7L << ' ' << 3000000000u << ' ' << 1.5f << ' ' << true << ' '
+		   << std::boolalpha << false << ' ' << std::hex << 255 << std::dec << ' ' << std::fixed << std::setprecision(2)
+		   << 3.14159 << ' ' << std::setw(6) << std::setfill('*') << 12 << '|' << std::setw(4) << "ab" << '|' 
+		   << static_cast<char>(1) << std::string("end");
+	};
+	{
+		Logger::setDefaultRealtimeLogger(out);
+		Logger log = Logger::getLogger('R');
+		message(log.info());
+		Logger::setDefaultRealtimeLogger(sink());
+	}
+	message(expected);
+	EXPECT_EQ(expected.str(), "values 42 -7 3000000000 1.5 1 false ff 3.14 ****12|**ab|\001end");
+	EXPECT_NE(out.str().find("I:  " + expected.str() + "\033[0m"), std::string::npos);
+}
@@ -0,0 +1,150 @@
+#include <eeros/task/Async.hpp>
+#include <eeros/task/Lambda.hpp>
+#include <eeros/core/VirtualClock.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::task;
+
+namespace {
+// a task which blocks in every cycle until the gate is opened
+struct Gate {
+  void pass() {
+    entered = true;
+    while (!open) std::this_thread::yield();
+    cycles++;
+  }
+  std::atomic<bool> entered{false};
+  std::atomic<bool> open{false};
+  std::atomic<int> cycles{0};
+};
+
+// waits for a condition, with a timeout in the time of the system
+template < typename F >
+bool await(F condition) {
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > end) return false;
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+// releases a task three times in virtual time, the second and third time 5 ms after the first 
+// while the first cycle is running, lets the first cycle finish 20 ms after it was released 
+// and stops the thread once all cycles have run
+void releaseThrice(Async &async, Gate &gate) {
+  async.waitReady(1.0);
+  VirtualClock::enable(1000000000);
+  async.run();
+  EXPECT_TRUE(await([&] { return gate.entered.load(); }));
+  VirtualClock::advance(5000000);
+  async.run();
+  async.run();
+  VirtualClock::advance(15000000);
+  gate.open = true;
+  EXPECT_TRUE(await([&] { return async.isIdle(); }));
+  async.stop();
+  async.join();
+  VirtualClock::disable();
+}
+}
+
+// Every missed cycle is run later on
+TEST(taskAsyncTest, catchUp) {
+  Gate gate;
+  Lambda slow([&] { gate.pass(); });
+  Async async(slow);
+  releaseThrice(async, gate);
+  EXPECT_EQ(gate.cycles, 3);
+  EXPECT_EQ(async.counter.missed.load(), 2);
+  EXPECT_EQ(async.counter.overruns.load(), 1);
+  EXPECT_DOUBLE_EQ(async.counter.maxLateness.load(), 0.015);
+}
+
+// Cycles released while the thread is busy are dropped
+TEST(taskAsyncTest, skip) {
+  Gate gate;
+  Lambda slow([&] { gate.pass(); });
+  Async async(slow);
+  async.setOverrunPolicy(OverrunPolicy::skip);
+  releaseThrice(async, gate);
+  EXPECT_EQ(gate.cycles, 1);
+  EXPECT_EQ(async.counter.missed.load(), 2);
+  EXPECT_EQ(async.counter.overruns.load(), 1);
+  EXPECT_DOUBLE_EQ(async.counter.maxLateness.load(), 0.015);
+}
+
+// Cycles released while the thread is busy are run once
+TEST(taskAsyncTest, coalesce) {
+  Gate gate;
+  Lambda slow([&] { gate.pass(); });
+  Async async(slow);
+  async.setOverrunPolicy(OverrunPolicy::coalesce);
+  releaseThrice(async, gate);
+  EXPECT_EQ(gate.cycles, 2);
+  EXPECT_EQ(async.counter.missed.load(), 2);
+  EXPECT_EQ(async.counter.overruns.load(), 1);
+  EXPECT_DOUBLE_EQ(async.counter.maxLateness.load(), 0.015);
+}
+
+// A cycle released after the previous one has finished is no deadline miss
+TEST(taskAsyncTest, onTime) {
+  std::atomic<int> cycles(0);
+  Lambda fast([&] { cycles++; });
+  Async async(fast);
+  async.setOverrunPolicy(OverrunPolicy::skip);
+  async.waitReady(1.0);
+  for (int i = 0; i < 3; i++) {
+    async.run();
+    EXPECT_TRUE(await([&] { return cycles == i + 1 && async.isIdle(); }));
+  }
+  async.stop();
+  async.join();
+  EXPECT_EQ(cycles, 3);
+  EXPECT_EQ(async.counter.missed.load(), 0);
+  EXPECT_EQ(async.counter.overruns.load(), 0);
+  EXPECT_THROW(async.setOverrunPolicy(OverrunPolicy::triggerEvent), std::runtime_error);
+}
+
+// With a period, only the first call of run() starts the thread, further calls have no effect
+TEST(taskAsyncTest, periodic) {
+  std::atomic<int> cycles(0);
+  Lambda fast([&] { cycles++; });
+  Async async(fast, false, 0, {}, 0.001);
+  async.waitReady(1.0);
+  for (int i = 0; i < 3; i++) async.run();
+  EXPECT_TRUE(await([&] { return cycles > 0; }));
+  EXPECT_TRUE(async.isIdle());
+  async.stop();
+  async.join();
+}
+
+namespace {
+// uses about 64 KiB of stack
+__attribute__((noinline)) int deep(int depth) {
+  volatile char frame[1024];
+  frame[0] = static_cast<char>(depth);
+  return (depth > 0) ? deep(depth - 1) + frame[0] : frame[0];
+}
+}
+
+// The thread runs with the given stack size, whose usage is measured
+TEST(taskAsyncTest, stack) {
+  Lambda recurse([] { deep(64); });
+  Async async(recurse, false, 0, {}, 0, "stack", 256 * 1024);
+  async.waitReady(1.0);
+  async.run();
+  EXPECT_TRUE(await([&] { return async.isIdle(); }));
+  async.stop();
+  async.join();
+  EXPECT_GE(async.getStackSize(), 240u * 1024);
+  EXPECT_LE(async.getStackSize(), 256u * 1024);
+  EXPECT_GE(async.getStackHighWater(), 64u * 1024);
+  EXPECT_LT(async.getStackHighWater(), 240u * 1024);
+  EXPECT_THROW(Async(recurse, false, 0, {}, 0, "small", 1024), std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include <eeros/task/HarmonicTaskList.hpp>
+#include <eeros/task/Lambda.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::task;
+
+// Without a phase, a task runs on every n-th call, starting with call n - 1
+TEST(taskHarmonicTest, phase) {
+  std::vector<int> calls;
+  int i = 0;
+  Lambda l([&] { calls.push_back(i); });
+  Harmonic h0(l, 4), h2(l, 4, 2), h5(l, 4, 5);
+  for (i = 0; i < 8; i++) h0.run();
+  EXPECT_EQ(calls, std::vector<int>({3, 7}));
+  calls.clear();
+  for (i = 0; i < 8; i++) h2.run();
+  EXPECT_EQ(calls, std::vector<int>({1, 5}));
+  calls.clear();
+  EXPECT_EQ(h5.getPhase(), 1);
+  for (i = 0; i < 8; i++) h5.run();
+  EXPECT_EQ(calls, std::vector<int>({0, 4}));
+}
+
+// Shifting the phase while running keeps the period
+TEST(taskHarmonicTest, setPhase) {
+  std::vector<int> calls;
+  int i = 0;
+  Lambda l([&] { calls.push_back(i); });
+  Harmonic h(l, 4);
+  for (i = 0; i < 5; i++) h.run();
+  h.setPhase(2);
+  for (; i < 12; i++) h.run();
+  EXPECT_EQ(calls, std::vector<int>({3, 5, 9}));
+}
+
+// Tasks with the same period are spread over the base periods
+TEST(taskHarmonicTaskListTest, stagger) {
+  Lambda l;
+  HarmonicTaskList list;
+  list.add(l, 1);
+  list.add(l, 5);
+  list.add(l, 10);
+  list.add(l, 10);
+  list.add(l, 20);
+  EXPECT_EQ(list.getHyperperiod(), 20);
+  std::vector<double> runTimes = {1, 2, 2, 2, 2};
+  EXPECT_EQ(list.getPeakLoad(runTimes), 9);
+  list.stagger(runTimes);
+  EXPECT_EQ(list.getPeakLoad(runTimes), 3);
+  EXPECT_EQ(list.tasks[0].getPhase(), 0);
+  EXPECT_THROW(list.stagger({1, 2}), std::invalid_argument);
+  EXPECT_THROW(list.getPeakLoad({1, 2, 2, 2, 2, 2}), std::invalid_argument);
+}
+
+// Tasks with a fixed phase are not moved
+TEST(taskHarmonicTaskListTest, fixed) {
+  Lambda l;
+  HarmonicTaskList list;
+  list.add(l, 2, 1);
+  list.add(l, 2, 1);
+  std::vector<double> runTimes = {1, 1};
+  list.stagger(runTimes, {true, false});
+  EXPECT_EQ(list.tasks[0].getPhase(), 1);
+  EXPECT_EQ(list.tasks[1].getPhase(), 0);
+  EXPECT_EQ(list.getPeakLoad(runTimes), 1);
+}
@@ -0,0 +1,448 @@
+#include <eeros/core/Executor.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/core/Version.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/task/Lambda.hpp>
+#include <eeros/task/Periodic.hpp>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Measures the period and the jitter of the executor thread like cyclictest, optionally
+// under background load. Every combination of the given periods, priorities and cpu sets
+// runs in a process of its own, as the executor can only run once per process.
+
+using namespace eeros;
+
+namespace {
+
+struct Config {
+	double period;
+	int priority;
+	std::vector<int> cpus;  // empty if not pinned
+};
+
+struct Load {
+	int cpu = 0;          // number of threads spinning
+	int memory = 0;       // number of threads copying memory
+	int io = 0;           // number of threads writing to a file
+	std::size_t memorySize = 64;  // MiB per memory thread
+	std::size_t ioSize = 64;      // MiB per io thread
+	std::string ioDir = "/tmp";
+};
+
+// sent from the measuring process to the parent through a pipe
+struct Result {
+	bool ok;
+	bool priorityRaised;
+	uint64_t overruns;
+	uint64_t missed;
+	double maxLateness;
+	PeriodicCounter::Snapshot histograms;
+};
+
+std::vector<std::string> split(const std::string &s, char separator) {
+	std::vector<std::string> parts;
+	std::stringstream ss(s);
+	std::string part;
+	while (std::getline(ss, part, separator)) if (!part.empty()) parts.push_back(part);
+	return parts;
+}
+
+// parses a cpu list as used by the kernel, e.g. "1,4-6", "none" for no pinning
+std::vector<int> parseCpus(const std::string &list) {
+	std::vector<int> cpus;
+	if (list == "none") return cpus;
+	for (auto &range : split(list, ',')) {
+		auto dash = range.find('-');
+		int first = std::stoi(range.substr(0, dash));
+		int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+		for (int i = first; i <= last; i++) cpus.push_back(i);
+	}
+	return cpus;
+}
+
+std::string cpuName(const std::vector<int> &cpus) {
+	return cpus.empty() ? "none" : Executor::cpu_list(cpus);
+}
+
+std::string loadName(const Load &load) {
+	std::ostringstream os;
+	os << "cpu=" << load.cpu << " memory=" << load.memory << " io=" << load.io;
+	return os.str();
+}
+
+// background load, runs in normal threads without realtime priority
+class LoadGenerator {
+ public:
+	LoadGenerator(const Load &load) : stop(false) {
+		for (int i = 0; i < load.cpu; i++) threads.emplace_back([this] {
+			volatile double x = 1.0;
+			while (!stop.load(std::memory_order_relaxed)) for (int j = 0; j < 10000; j++) x = std::sqrt(x + j);
+		});
+		for (int i = 0; i < load.memory; i++) threads.emplace_back([this, &load] {
+			std::size_t half = load.memorySize * 1024 * 1024 / 2;
+			std::unique_ptr<char[]> buffer(new char[2 * half]);
+			std::memset(buffer.get(), 1, 2 * half);
+			while (!stop.load(std::memory_order_relaxed)) {
+				std::memcpy(buffer.get(), buffer.get() + half, half);
+				std::memcpy(buffer.get() + half, buffer.get(), half);
+			}
+		});
+		for (int i = 0; i < load.io; i++) threads.emplace_back([this, &load] {
+			std::string name = load.ioDir + "/eerosLatencyXXXXXX";
+			int fd = mkstemp(&name[0]);
+			if (fd < 0) {
+				std::cerr << "Error: could not create a file in '" << load.ioDir << "'" << std::endl;
+				return;
+			}
+			unlink(name.c_str());
+			std::vector<char> block(1024 * 1024, 1);
+			std::size_t written = 0;
+			while (!stop.load(std::memory_order_relaxed)) {
+				if (write(fd, block.data(), block.size()) < 0) break;
+				fsync(fd);
+				written += block.size();
+				if (written >= load.ioSize * 1024 * 1024) {
+					if (ftruncate(fd, 0) < 0 || lseek(fd, 0, SEEK_SET) < 0) break;
+					written = 0;
+				}
+			}
+			close(fd);
+		});
+	}
+
+	~LoadGenerator() {
+		stop = true;
+		for (auto &t : threads) t.join();
+	}
+
+ private:
+	std::atomic<bool> stop;
+	std::vector<std::thread> threads;
+};
+
+bool writeAll(int fd, const void *data, std::size_t size) {
+	auto p = static_cast<const char*>(data);
+	while (size > 0) {
+		ssize_t n = write(fd, p, size);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) return false;
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+bool readAll(int fd, void *data, std::size_t size) {
+	auto p = static_cast<char*>(data);
+	while (size > 0) {
+		ssize_t n = read(fd, p, size);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) return false;
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+// runs in the forked process, measures the executor thread in a single configuration
+void measure(int fd, const Config &config, const Load &load, double warmup, double seconds) {
+	std::unique_ptr<Result> result(new Result());
+	result->ok = false;
+	result->priorityRaised = true;
+	uint64_t warmupCycles = std::max<uint64_t>(std::llround(warmup / config.period), 1);
+	uint64_t cycles = std::max<uint64_t>(std::llround(seconds / config.period), 1);
+	try {
+		LoadGenerator generator(load);
+		auto &executor = Executor::instance();
+		task::Lambda nothing;
+		task::Periodic measured("latency", config.period, nothing);
+		uint64_t ticks = 0;
+		measured.monitors.push_back([&](PeriodicCounter &c, logger::Logger &log) {
+			ticks++;
+			// the executor raises its thread to its base priority before the first cycle
+			if (ticks == 1 && config.priority != Executor::basePriority)
+				result->priorityRaised = Executor::set_priority(Executor::basePriority - config.priority);
+			if (ticks == warmupCycles) c.reset();
+			if (ticks == warmupCycles + cycles) Executor::stop();
+		});
+		executor.setMainTask(measured);
+		if (!config.cpus.empty()) executor.setCpus(config.cpus);
+		executor.run();
+		executor.counter.snapshot(result->histograms);
+		result->overruns = executor.counter.overruns.load(std::memory_order_relaxed);
+		result->missed = executor.counter.missed.load(std::memory_order_relaxed);
+		result->maxLateness = executor.counter.maxLateness.load(std::memory_order_relaxed);
+		result->ok = true;
+	} catch (std::exception &e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+	}
+	writeAll(fd, result.get(), sizeof(Result));
+}
+
+bool run(const Config &config, const Load &load, double warmup, double seconds, Result &result) {
+	int fds[2];
+	if (pipe(fds) < 0) return false;
+	pid_t pid = fork();
+	if (pid < 0) return false;
+	if (pid == 0) {
+		close(fds[0]);
+		measure(fds[1], config, load, warmup, seconds);
+		close(fds[1]);
+		_exit(0);
+	}
+	close(fds[1]);
+	bool ok = readAll(fds[0], &result, sizeof(Result));
+	close(fds[0]);
+	int status;
+	waitpid(pid, &status, 0);
+	return ok && result.ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+struct Entry {
+	Config config;
+	std::unique_ptr<Result> result;
+};
+
+void writeSummary(std::ostream &os, const Histogram::Snapshot &h) {
+	os << h.min << ',' << std::llround(h.mean()) << ',' << h.percentile(50) << ',' << h.percentile(99) << ','
+	   << h.percentile(99.9) << ',' << h.max;
+}
+
+void writeCsv(std::ostream &os, const Load &load, const std::vector<Entry> &entries) {
+	os << "period_ns,priority,cpus,load,cycles,overruns,missed,max_lateness_ns";
+	for (auto h : {"period", "jitter"})
+		for (auto s : {"min", "mean", "p50", "p99", "p99.9", "max"}) os << ',' << h << '_' << s << "_ns";
+	os << '\n';
+	for (auto &e : entries) {
+		os << std::llround(e.config.period * 1e9) << ',' << e.config.priority << ",\"" << cpuName(e.config.cpus) << "\",\""
+		   << loadName(load) << "\"," << e.result->histograms.period.count << ',' << e.result->overruns << ','
+		   << e.result->missed << ',' << std::llround(e.result->maxLateness * 1e9) << ',';
+		writeSummary(os, e.result->histograms.period);
+		os << ',';
+		writeSummary(os, e.result->histograms.jitter);
+		os << '\n';
+	}
+}
+
+// one row per non-empty bucket, the bucket holds the values from lower to upper bound
+void writeCsvHistograms(std::ostream &os, const std::vector<Entry> &entries) {
+	os << "period_ns,priority,cpus,histogram,lower_ns,upper_ns,count\n";
+	for (auto &e : entries) {
+		auto rows = [&](const char *name, const Histogram::Snapshot &h) {
+			for (std::size_t i = 0; i < Histogram::nofBuckets; i++) {
+				if (h.buckets[i] == 0) continue;
+				uint64_t upper = (i + 1 < Histogram::nofBuckets) ? Histogram::lowerBound(i + 1) - 1 : h.max;
+				os << std::llround(e.config.period * 1e9) << ',' << e.config.priority << ",\"" << cpuName(e.config.cpus) << "\","
+				   << name << ',' << Histogram::lowerBound(i) << ',' << upper << ',' << h.buckets[i] << '\n';
+			}
+		};
+		rows("period", e.result->histograms.period);
+		rows("jitter", e.result->histograms.jitter);
+	}
+}
+
+void writeJsonHistogram(std::ostream &os, const Histogram::Snapshot &h) {
+	os << "{\"min\": " << h.min << ", \"mean\": " << std::llround(h.mean()) << ", \"p50\": " << h.percentile(50)
+	   << ", \"p99\": " << h.percentile(99) << ", \"p99.9\": " << h.percentile(99.9) << ", \"max\": " << h.max
+	   << ", \"count\": " << h.count << ", \"buckets\": [";
+	bool first = true;
+	for (std::size_t i = 0; i < Histogram::nofBuckets; i++) {
+		if (h.buckets[i] == 0) continue;
+		os << (first ? "" : ", ") << '[' << Histogram::lowerBound(i) << ", " << h.buckets[i] << ']';
+		first = false;
+	}
+	os << "]}";
+}
+
+void writeJson(std::ostream &os, const Load &load, double warmup, double seconds, const std::vector<Entry> &entries) {
+	os << "{\n  \"eeros\": \"" << Version::string << "\",\n"
+	   << "  \"unit\": \"ns\",\n"
+	   << "  \"warmup\": " << warmup << ",\n"
+	   << "  \"duration\": " << seconds << ",\n"
+	   << "  \"load\": {\"cpu\": " << load.cpu << ", \"memory\": " << load.memory << ", \"memorySize\": " << load.memorySize
+	   << ", \"io\": " << load.io << ", \"ioSize\": " << load.ioSize << "},\n"
+	   << "  \"results\": [";
+	bool first = true;
+	for (auto &e : entries) {
+		os << (first ? "\n" : ",\n");
+		first = false;
+		os << "    {\"period\": " << std::llround(e.config.period * 1e9) << ", \"priority\": " << e.config.priority
+		   << ", \"cpus\": \"" << cpuName(e.config.cpus) << "\", \"priorityRaised\": " << (e.result->priorityRaised ? "true" : "false")
+		   << ", \"overruns\": " << e.result->overruns << ", \"missed\": " << e.result->missed
+		   << ", \"maxLateness\": " << std::llround(e.result->maxLateness * 1e9) << ",\n     \"periodHistogram\": ";
+		writeJsonHistogram(os, e.result->histograms.period);
+		os << ",\n     \"jitterHistogram\": ";
+		writeJsonHistogram(os, e.result->histograms.jitter);
+		os << "}";
+	}
+	os << "\n  ]\n}\n";
+}
+
+void usage(const char *name) {
+	std::cerr << "Usage: " << name << " <option(s)>\n"
+		<< "Measures period and jitter of the executor thread in every combination of periods, priorities and cpus.\n"
+		<< "Options:\n"
+		<< "\t-p PERIODS\tcomma separated periods in seconds, default 0.001\n"
+		<< "\t-r PRIORITIES\tcomma separated realtime priorities (1-99), default " << Executor::basePriority << "\n"
+		<< "\t-c CPUS\t\tcpus to pin the executor thread to, e.g. 1 or 2-3, none for no pinning;\n"
+		<< "\t\t\tcan be given several times, default none\n"
+		<< "\t-s SECONDS\tmeasuring time per combination, default 10\n"
+		<< "\t-w SECONDS\twarmup time per combination which is not measured, default 1\n"
+		<< "\t-l LOAD\t\tbackground load, e.g. cpu=2,memory=1,io=1 for the number of threads\n"
+		<< "\t-m MIB\t\tmemory copied by each memory load thread, default 64\n"
+		<< "\t-i MIB,DIR\tfile size and directory of each io load thread, default 64,/tmp\n"
+		<< "\t-o FILE\t\twrites the report to FILE, as JSON if it ends with .json and as CSV otherwise,\n"
+		<< "\t\t\tthe histograms of a CSV report are written to FILE.histograms.csv\n"
+		<< "\t-v\t\tlogs the output of the executor\n"
+		<< "\t-h\t\tshows this help message\n"
+		<< "Realtime priorities and locking memory require root or CAP_SYS_NICE and CAP_IPC_LOCK." << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	std::vector<double> periods = {0.001};
+	std::vector<int> priorities = {Executor::basePriority};
+	std::vector<std::vector<int>> cpuSets;
+	double seconds = 10, warmup = 1;
+	Load load;
+	std::string output;
+	bool verbose = false;
+
+	int c;
+	try {
+		while ((c = getopt(argc, argv, "p:r:c:s:w:l:m:i:o:vh")) != -1) {
+			switch (c) {
+				case 'p':
+					periods.clear();
+					for (auto &p : split(optarg, ',')) periods.push_back(std::stod(p));
+					break;
+				case 'r':
+					priorities.clear();
+					for (auto &p : split(optarg, ',')) priorities.push_back(std::stoi(p));
+					break;
+				case 'c':
+					cpuSets.push_back(parseCpus(optarg));
+					break;
+				case 's':
+					seconds = std::stod(optarg);
+					break;
+				case 'w':
+					warmup = std::stod(optarg);
+					break;
+				case 'l':
+					for (auto &l : split(optarg, ',')) {
+						auto eq = l.find('=');
+						if (eq == std::string::npos) throw std::invalid_argument(l);
+						int n = std::stoi(l.substr(eq + 1));
+						std::string kind = l.substr(0, eq);
+						if (kind == "cpu") load.cpu = n;
+						else if (kind == "memory") load.memory = n;
+						else if (kind == "io") load.io = n;
+						else throw std::invalid_argument(l);
+					}
+					break;
+				case 'm':
+					load.memorySize = std::stoul(optarg);
+					break;
+				case 'i': {
+					auto parts = split(optarg, ',');
+					if (parts.empty()) throw std::invalid_argument(optarg);
+					load.ioSize = std::stoul(parts[0]);
+					if (parts.size() > 1) load.ioDir = parts[1];
+					break;
+				}
+				case 'o':
+					output = optarg;
+					break;
+				case 'v':
+					verbose = true;
+					break;
+				default:
+					usage(argv[0]);
+					return c == 'h' ? 0 : 1;
+			}
+		}
+	} catch (std::exception &e) {
+		std::cerr << "Error: invalid argument of option -" << char(c) << std::endl;
+		usage(argv[0]);
+		return 1;
+	}
+	if (cpuSets.empty()) cpuSets.push_back({});
+	for (auto p : periods) {
+		if (p <= 0) {
+			std::cerr << "Error: periods must be positive" << std::endl;
+			return 1;
+		}
+	}
+	for (auto p : priorities) {
+		if (p < 1 || p > 99) {
+			std::cerr << "Error: priorities must be between 1 and 99" << std::endl;
+			return 1;
+		}
+	}
+	if (verbose) logger::Logger::setDefaultStreamLogger(std::cerr);
+
+	std::cout << "eeros " << Version::string << ", load " << loadName(load) << ", " << seconds << " sec per combination" << std::endl;
+	std::cout << std::setw(10) << "period" << std::setw(6) << "prio" << std::setw(10) << "cpus"
+		<< std::setw(12) << "p50 [us]" << std::setw(12) << "p99 [us]" << std::setw(12) << "p99.9 [us]"
+		<< std::setw(12) << "max [us]" << std::setw(10) << "overruns" << std::endl;
+	std::vector<Entry> entries;
+	int failed = 0;
+	for (auto &cpus : cpuSets) {
+		for (auto priority : priorities) {
+			for (auto period : periods) {
+				Entry e{{period, priority, cpus}, std::unique_ptr<Result>(new Result())};
+				std::cout << std::setw(10) << period << std::setw(6) << priority << std::setw(10) << cpuName(cpus) << std::flush;
+				if (!run(e.config, load, warmup, seconds, *e.result)) {
+					std::cout << "  failed" << std::endl;
+					failed++;
+					continue;
+				}
+				auto &j = e.result->histograms.jitter;
+				std::cout << std::fixed << std::setprecision(1)
+					<< std::setw(12) << j.percentile(50) / 1000.0 << std::setw(12) << j.percentile(99) / 1000.0
+					<< std::setw(12) << j.percentile(99.9) / 1000.0 << std::setw(12) << j.max / 1000.0
+					<< std::setw(10) << e.result->overruns << (e.result->priorityRaised ? "" : "  (priority not set)")
+					<< std::defaultfloat << std::endl;
+				entries.push_back(std::move(e));
+			}
+		}
+	}
+	std::cout << "jitter is the absolute deviation of the period from its nominal value" << std::endl;
+
+	if (!output.empty()) {
+		std::ofstream file(output);
+		if (!file.is_open()) {
+			std::cerr << "Error: could not open '" << output << "'" << std::endl;
+			return 1;
+		}
+		bool json = output.size() >= 5 && output.compare(output.size() - 5, 5, ".json") == 0;
+		if (json) {
+			writeJson(file, load, warmup, seconds, entries);
+		} else {
+			writeCsv(file, load, entries);
+			std::ofstream histograms(output + ".histograms.csv");
+			writeCsvHistograms(histograms, entries);
+		}
+	}
+	return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+#include <eeros/core/Tracer.hpp>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// converts a trace file written by eeros::Tracer::save() into the Chrome trace format,
+// which can be opened with chrome://tracing or https://ui.perfetto.dev
+int main(int argc, char *argv[]) {
+	if (argc < 2 || argc > 3 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+		std::cerr << "Usage: " << argv[0] << " <trace file> [json file]\n"
+			<< "\tWrites the trace in the Chrome trace format to the json file or to stdout"
+			<< std::endl;
+		return 1;
+	}
+	try {
+		if (argc == 3) {
+			std::ofstream file(argv[2]);
+			if (!file.is_open()) {
+				std::cerr << "Error: could not open '" << argv[2] << "'" << std::endl;
+				return 1;
+			}
+			eeros::Tracer::convert(argv[1], file);
+		} else {
+			eeros::Tracer::convert(argv[1], std::cout);
+		}
+	} catch (std::exception &e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}